@@ -1,12 +1,128 @@
 #ifndef MOD_NUM
 
+#include <gmpxx.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace modular
 {
 
+    /**
+     * @brief Selects a type wide enough to hold the product of two values of type T.
+     * Built-in integers are widened to the next native width, other types (mpz_class)
+     * are unbounded and are used as is.
+     * @tparam T The type of value in the modular number.
+     */
+    template <typename T>
+    struct wideType
+    {
+        using type = typename std::conditional<
+            !std::is_integral<T>::value, T,
+            typename std::conditional<
+                (sizeof(T) <= 4),
+                typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type,
+                typename std::conditional<std::is_signed<T>::value, __int128, unsigned __int128>::type>::type>::type;
+    };
+
+    /**
+     * @brief Barrett reduction for word-size moduli.
+     * Keeps mu = floor(2^128 / MOD) so that a 128-bit product is reduced with
+     * three 64x64 multiplications and a few corrective subtractions.
+     */
+    class BarrettReducer
+    {
+    private:
+        uint64_t MOD;
+        unsigned __int128 mu;
+
+    public:
+        /**
+         * @brief Constructor for the BarrettReducer class.
+         * @param _MOD The modulus value.
+         * @throws std::invalid_argument if modulus is zero.
+         */
+        constexpr explicit BarrettReducer(uint64_t _MOD);
+
+        /**
+         * @brief Getter for the modulus value.
+         * @return The modulus of the reducer.
+         */
+        constexpr uint64_t getMod() const { return MOD; }
+
+        /**
+         * @brief Reduces a 128-bit value modulo MOD.
+         * @param x The value to reduce.
+         * @return x mod MOD.
+         */
+        constexpr uint64_t reduce(unsigned __int128 x) const noexcept;
+
+        /**
+         * @brief Multiplication of two values modulo MOD.
+         * @param value1 The first value.
+         * @param value2 The second value.
+         * @return The result of the multiplication modulo MOD.
+         */
+        constexpr uint64_t mult(uint64_t value1, uint64_t value2) const noexcept
+        {
+            return reduce(static_cast<unsigned __int128>(value1) * value2);
+        }
+    };
+
+    /**
+     * @brief Returns a Barrett reducer for a modulus, shared by the calling thread.
+     * The reducer of the last modulus asked for is kept, so a chain of products
+     * with one modulus builds it once and elements do not have to carry it.
+     * @param MOD The positive modulus value.
+     * @return The reducer for MOD, valid until the thread asks for another modulus.
+     */
+    inline const BarrettReducer &sharedReducer(uint64_t MOD);
+
+    /**
+     * @brief Stand-in for the Barrett reducer of types that do not use one.
+     */
+    struct noReducer
+    {
+    };
+
+    /**
+     * @brief Selects the reducer stored next to a modulus of type T.
+     * Built-in integers up to 64 bits keep a BarrettReducer, other types keep nothing.
+     * @tparam T The type of the modulus.
+     */
+    template <typename T>
+    struct reducerType
+    {
+        using type = typename std::conditional<std::is_integral<T>::value && (sizeof(T) <= sizeof(uint64_t)),
+                                               BarrettReducer, noReducer>::type;
+    };
+
+    /**
+     * @brief Builds the reducer for a modulus.
+     * @param MOD The modulus value.
+     * @return A BarrettReducer for built-in integers, noReducer otherwise.
+     * @throws std::invalid_argument if a built-in modulus is zero.
+     */
+    template <typename T>
+    typename reducerType<T>::type makeReducer(const T &MOD);
+
+    /**
+     * @brief Tag for constructing a modNum from a value that is already reduced.
+     */
+    struct reducedTag
+    {
+    };
+
     /**
      *
      * @brief A class representing a modular number with value of type T.
@@ -27,7 +143,7 @@ namespace modular
          * @return The result of the addition modulo MOD.
          */
 
-        T add(T value1, T value2, T MOD) const;
+        T add(T value1, T value2, T MOD) const noexcept(std::is_integral<T>::value);
 
         /**
          * @brief Subtraction of two values modulo MOD.
@@ -37,7 +153,7 @@ namespace modular
          * @return The result of the subtraction modulo MOD.
          */
 
-        T subs(T value1, T value2, T MOD) const;
+        T subs(T value1, T value2, T MOD) const noexcept(std::is_integral<T>::value);
 
         /**
          * @brief Multiplication of two values modulo MOD.
@@ -47,7 +163,7 @@ namespace modular
          * @return The result of the multiplication modulo MOD.
          */
 
-        T mult(T value1, T value2, T MOD) const;
+        T mult(T value1, T value2, T MOD) const noexcept(std::is_integral<T>::value);
 
         /**
          * @brief Calculates the inverse of a value modulo MOD.
@@ -79,10 +195,20 @@ namespace modular
             {
                 throw std::invalid_argument("modulus should be positive");
             }
-            value = (_value % _MOD + _MOD) % _MOD;
+            value = _value % _MOD;
+            if (value < 0)
+                value += _MOD;
             MOD = _MOD;
         }
 
+        /**
+         * @brief Unchecked constructor for a value already in range [0, _MOD).
+         * Skips the validation and the reduction, the arguments are moved in.
+         * @param _value The reduced value.
+         * @param _MOD The positive modulus value.
+         */
+        modNum(T _value, T _MOD, reducedTag) : value(std::move(_value)), MOD(std::move(_MOD)) {}
+
         /**
          * @brief Getter for the value.
          * @return The current value.
@@ -96,7 +222,7 @@ namespace modular
         T getMod() const { return MOD; };
 
         /**
-         * @brief Setter for the modulus value.
+         * @brief Setter for the modulus value, the value is reduced by the new modulus.
          * @param MOD The new modulus value to be set.
          */
 
@@ -146,30 +272,58 @@ namespace modular
          * @return The inverse of the modNum.
          */
         modNum<T> inv();
+        /**
+         * @brief In-place addition operator.
+         * @param other The modNum to add.
+         * @return Reference to this modNum.
+         */
+        modNum<T> &operator+=(const modNum<T> &other);
+        /**
+         * @brief In-place subtraction operator.
+         * @param other The modNum to subtract.
+         * @return Reference to this modNum.
+         */
+        modNum<T> &operator-=(const modNum<T> &other);
+        /**
+         * @brief In-place multiplication operator.
+         * @param other The modNum to multiply.
+         * @return Reference to this modNum.
+         */
+        modNum<T> &operator*=(const modNum<T> &other);
+        /**
+         * @brief In-place division operator.
+         * @param other The modNum to divide by.
+         * @return Reference to this modNum.
+         */
+        modNum<T> &operator/=(const modNum<T> &other);
         /**
          * @brief Addition operator.
          * @param other The modNum to add.
          * @return The result of the addition.
          */
-        modNum<T> operator+(const modNum<T> &other) const;
+        modNum<T> operator+(const modNum<T> &other) const &;
+        modNum<T> operator+(const modNum<T> &other) &&;
         /**
          * @brief Subtraction operator.
          * @param other The modNum to subtract.
          * @return The result of the subtraction.
          */
-        modNum<T> operator-(const modNum<T> &other) const;
+        modNum<T> operator-(const modNum<T> &other) const &;
+        modNum<T> operator-(const modNum<T> &other) &&;
         /**
          * @brief Multiplication operator.
          * @param other The modNum to multiply.
          * @return The result of the multiplication.
          */
-        modNum<T> operator*(const modNum<T> &other) const;
+        modNum<T> operator*(const modNum<T> &other) const &;
+        modNum<T> operator*(const modNum<T> &other) &&;
         /**
          * @brief Division operator.
          * @param other The modNum to divide by.
          * @return The result of the division.
          */
-        modNum<T> operator/(const modNum<T> &other) const;
+        modNum<T> operator/(const modNum<T> &other) const &;
+        modNum<T> operator/(const modNum<T> &other) &&;
 
         /**
          * @brief Abstract base class for factorization strategies.
@@ -191,6 +345,8 @@ namespace modular
         };
         /**
          * @brief Implementation of the Pollard factorization strategy.
+         *
+         * Multi-word values get a cheap p - 1 pass before Pollard's rho.
          */
         template <typename T1>
         class Pollard : public Factorization<T1>
@@ -219,8 +375,129 @@ namespace modular
             std::vector<T1> factor(T1 m) override;
         };
 
+        /**
+         * @brief Implementation of the elliptic curve (Lenstra ECM) factorization strategy.
+         * Montgomery curves with Suyama's parametrization, a prime-power stage 1 up to B1
+         * and a baby-step giant-step stage 2 up to B2 = 100 * B1. B1 and the number of
+         * curves grow with the size of the factor looked for; the curves of one level
+         * run in parallel, after a short p - 1 pass. Word-sized cofactors and failed searches
+         * fall back to Pollard's rho.
+         */
+        template <typename T1>
+        class ECM : public Factorization<T1>
+        {
+        private:
+            size_t threads, maxDigits;
+
+        public:
+            /**
+             * @brief Constructor for the ECM strategy.
+             * @param _threads The number of worker threads, 0 for one per hardware thread.
+             * @param _maxDigits The largest factor size, in decimal digits, to search for with ECM.
+             */
+            explicit ECM(size_t _threads = 0, size_t _maxDigits = 40) : threads(_threads), maxDigits(_maxDigits) {}
+
+            /**
+             * @brief Factorizes a value using the ECM strategy.
+             * @param value The value to factorize.
+             * @return A vector of factors.
+             */
+            std::vector<T1> factor(T1 value) override;
+        };
+
+        /**
+         * @brief Implementation of the self-initializing quadratic sieve (SIQS) factorization strategy.
+         * A Knuth-Schroeppel multiplier, polynomials switched in Gray code order, a sieve
+         * processed in 32 KB blocks and one large prime per relation. The polynomials are
+         * sieved in parallel. Structured elimination drops relations with a column of weight one
+         * and merges the pairs sharing a column of weight two before the dense elimination over
+         * GF(2). A short p - 1 pass runs first. Word-sized cofactors and failed searches fall back
+         * to Pollard's rho. The parameter table reaches siqsMaxDigits (100) digits and larger
+         * composites reuse its last row; sieving dominates the running time, about ten seconds
+         * per core at 60 digits and hours beyond 80.
+         */
+        template <typename T1>
+        class SIQS : public Factorization<T1>
+        {
+        private:
+            size_t threads;
+
+        public:
+            /**
+             * @brief Constructor for the SIQS strategy.
+             * @param _threads The number of worker threads, 0 for one per hardware thread.
+             */
+            explicit SIQS(size_t _threads = 0) : threads(_threads) {}
+
+            /**
+             * @brief Factorizes a value using the SIQS strategy.
+             * @param value The value to factorize.
+             * @return A vector of factors.
+             */
+            std::vector<T1> factor(T1 value) override;
+        };
+
+        /**
+         * @brief Implementation of the Pollard p - 1 factorization strategy.
+         * Finds the primes p with B1-smooth p - 1, up to one more prime below B2.
+         * Stage 1 raises 2 to every prime power up to B1; stage 2 pairs the primes
+         * m D - j and m D + j into one multiplication. Word-sized cofactors and
+         * failed searches fall back to Pollard's rho.
+         */
+        template <typename T1>
+        class PMinus1 : public Factorization<T1>
+        {
+        private:
+            uint64_t B1, B2;
+            std::vector<uint64_t> primes;
+
+        public:
+            /**
+             * @brief Constructor for the PMinus1 strategy, lists the primes up to B2 once.
+             * @param _B1 The stage 1 bound, every prime power up to it enters the exponent.
+             * @param _B2 The stage 2 bound, 0 for 100 * B1.
+             */
+            explicit PMinus1(uint64_t _B1 = 100000, uint64_t _B2 = 0);
+
+            /**
+             * @brief Factorizes a value using the PMinus1 strategy.
+             * @param value The value to factorize.
+             * @return A vector of factors.
+             */
+            std::vector<T1> factor(T1 value) override;
+        };
+
+        /**
+         * @brief Implementation of the Williams p + 1 factorization strategy.
+         * Finds the primes p with smooth p + 1 through Lucas sequences, with the same
+         * bounds and stage 2 as PMinus1. The seeds 2/7, 6/5 and 3/11 are tried in turn.
+         * Word-sized cofactors and failed searches fall back to Pollard's rho.
+         */
+        template <typename T1>
+        class PPlus1 : public Factorization<T1>
+        {
+        private:
+            uint64_t B1, B2;
+            std::vector<uint64_t> primes;
+
+        public:
+            /**
+             * @brief Constructor for the PPlus1 strategy, lists the primes up to B2 once.
+             * @param _B1 The stage 1 bound, every prime power up to it enters the exponent.
+             * @param _B2 The stage 2 bound, 0 for 100 * B1.
+             */
+            explicit PPlus1(uint64_t _B1 = 100000, uint64_t _B2 = 0);
+
+            /**
+             * @brief Factorizes a value using the PPlus1 strategy.
+             * @param value The value to factorize.
+             * @return A vector of factors.
+             */
+            std::vector<T1> factor(T1 value) override;
+        };
+
     private:
-        Factorization<T> *levelStrat;
+        Factorization<T> *levelStrat = nullptr;
 
     public:
         /**
@@ -253,109 +530,1293 @@ namespace modular
     };
 
     /**
-     * @brief Computes the power of a modNum value to a given base modNum.
-     * @param value The value to be raised to the power.
-     * @param base The base value.
-     * @param MOD The modulus value.
-     * @return The result of raising value to the power of base modulo MOD.
+     * @brief Precomputed Montgomery constants for a fixed odd modulus.
+     * Residues bound to the context (see montgomeryNum) are kept in Montgomery form
+     * (a * R mod MOD), so every multiplication costs one REDC instead of a division.
+     * @tparam T The type of value in the modular number.
      */
-    template <typename T1>
-    modNum<T1> pow(modNum<T1> value, modNum<T1> base, modNum<T1> MOD);
+    template <typename T>
+    class MontgomeryContext
+    {
+    public:
+        using wide = typename wideType<T>::type;
 
-    /**
-     * @brief Computes the fast power of a modNum value to a given degree.
-     * @param value The value to be raised to the power.
-     * @param degree The degree value.
-     * @return The result of raising value to the power of degree.
-     */
-    template <typename T1>
-    modNum<T1> fpow(modNum<T1> value, T1 degree);
+    private:
+        T MOD, rModN, rSquared;
+        wide R, mask, nPrime;
+        size_t rBits;
 
-    /**
-     * @brief Computes the fast power of a modNum value using Montgomery multiplication.
-     * @param value The value to be raised to the power.
-     * @param power The power value.
-     * @return The result of raising value to the power using Montgomery multiplication.
-     */
-    template <typename T>
-    modNum<T> fpowMontgomery(modNum<T> value, T power);
+    public:
+        /**
+         * @brief Constructor for the MontgomeryContext class.
+         * @param _MOD The odd modulus, built-in types require _MOD below half of their range.
+         * @throws std::invalid_argument if modulus is even, not greater than 1 or too big.
+         */
+        explicit MontgomeryContext(T _MOD);
 
-    /**
-     * @brief Factorizes a modNum value using the Pollard algorithm.
-     * @param value The value to factorize.
-     * @return A vector of factorized modNum values.
-     */
-    template <typename T1>
-    std::vector<modNum<T1>> factorize(modNum<T1> value);
+        /**
+         * @brief Checks if a context can be created for the modulus.
+         * @param _MOD The modulus value.
+         * @return True if the modulus is odd, greater than 1 and fits the type with a spare bit.
+         */
+        static bool supports(const T &_MOD);
 
-    /**
-     * @brief Factorizes a modNum value using the naive algorithm.
-     * @param value The value to factorize.
-     * @return A vector of factorized modNum values.
-     */
-    template <typename T1>
-    std::vector<modNum<T1>> naiveFactorize(modNum<T1> value);
+        /**
+         * @brief Getter for the modulus value.
+         * @return The modulus of the context.
+         */
+        T getMod() const { return MOD; }
 
-    /**
-     * @brief Computes the square root of a modNum value.
-     * @param value The value to compute the square root.
-     * @return A vector of modNum values representing the square root.
-     */
-    template <typename T1>
-    std::vector<T1> sqrt(modNum<T1> value);
+        /**
+         * @brief Getter for the number of bits of R.
+         * @return k such that R = 2^k.
+         */
+        size_t getRBits() const { return rBits; }
 
-    /**
-     * @brief Computes the discrete logarithm of a modNum value to a given base.
-     * @param value The value for which to compute the discrete logarithm.
-     * @param base The base value.
-     * @return The discrete logarithm of value with respect to base.
-     */
-    template <typename T1>
-    T1 log(modNum<T1> value, modNum<T1> base);
+        /**
+         * @brief Montgomery reduction.
+         * @param t The value to reduce, 0 <= t < MOD * R.
+         * @return t * R^-1 mod MOD.
+         */
+        T REDC(const wide &t) const;
 
-    /**
-     * @brief Checks if a modNum value is a multiplicative group generator.
-     * @param value The value to check.
-     * @return True if the value is a generator, otherwise false.
-     */
-    template <typename T1>
-    bool isGenerator(modNum<T1> value);
+        /**
+         * @brief Converts a value to Montgomery form.
+         * @param value The value in usual form.
+         * @return value * R mod MOD.
+         */
+        T toMontgomery(T value) const;
+
+        /**
+         * @brief Converts a value from Montgomery form.
+         * @param value The value in Montgomery form.
+         * @return value * R^-1 mod MOD.
+         */
+        T fromMontgomery(T value) const { return REDC(static_cast<wide>(value)); }
+
+        /**
+         * @brief Montgomery form of 1.
+         * @return R mod MOD.
+         */
+        T one() const { return rModN; }
+
+        /**
+         * @brief Multiplication of two values in Montgomery form.
+         * @param value1 The first value.
+         * @param value2 The second value.
+         * @return The product in Montgomery form.
+         */
+        T mult(T value1, T value2) const;
+
+        /**
+         * @brief Addition of two values in Montgomery form.
+         * @param value1 The first value.
+         * @param value2 The second value.
+         * @return The sum in Montgomery form.
+         */
+        T add(T value1, T value2) const;
+
+        /**
+         * @brief Subtraction of two values in Montgomery form.
+         * @param value1 The first value.
+         * @param value2 The second value.
+         * @return The difference in Montgomery form.
+         */
+        T subs(T value1, T value2) const;
+
+        /**
+         * @brief Binds a modNum to the context.
+         * @param num The modNum with the same modulus.
+         * @return The value of num in Montgomery form.
+         * @throws std::invalid_argument if moduli differ.
+         */
+        T fromModNum(const modNum<T> &num) const;
+
+        /**
+         * @brief Converts a value in Montgomery form back to modNum.
+         * @param value The value in Montgomery form.
+         * @return The modNum in usual form.
+         */
+        modNum<T> toModNum(T value) const { return modNum<T>(fromMontgomery(value), MOD); }
+    };
 
     /**
-     * @brief Computes the Euler's totient function of a modNum value.
-     * @param num The value for which to compute the Euler's totient function.
-     * @return The Euler's totient function value of num.
+     * @brief A modular number bound to a MontgomeryContext.
+     * The value is kept in Montgomery form, so a chain of operations converts once on the
+     * way in and once on the way out and every multiplication costs one REDC. The element
+     * stores only the residue and a pointer to the context, which must outlive it; both
+     * operands of an operation are expected to be bound to the same context.
+     * @tparam T The type of value in the modular number.
      */
     template <typename T>
-    modNum<T> eulerFunction(modNum<T> num);
+    class montgomeryNum
+    {
+    private:
+        const MontgomeryContext<T> *context;
+        T value;
 
-    /**
-     * @brief Computes the Carmichael function of a value.
-     * @param value The value for which to compute the Carmichael function.
-     * @return The Carmichael function value of value.
-     */
+        /**
+         * @brief Tag for constructing an element from a value already in Montgomery form.
+         */
+        struct formTag
+        {
+        };
+
+        montgomeryNum(const MontgomeryContext<T> &_context, T _value, formTag)
+            : context(&_context), value(std::move(_value)) {}
+
+    public:
+        /**
+         * @brief Constructor for the montgomeryNum class.
+         * @param _context The context to bind to.
+         * @param _value The initial value in usual form.
+         */
+        explicit montgomeryNum(const MontgomeryContext<T> &_context, T _value = 0)
+            : context(&_context), value(_context.toMontgomery(std::move(_value))) {}
+
+        /**
+         * @brief Binds a modNum to the context.
+         * @param _context The context to bind to.
+         * @param num The modNum with the modulus of the context.
+         * @throws std::invalid_argument if moduli differ.
+         */
+        montgomeryNum(const MontgomeryContext<T> &_context, const modNum<T> &num)
+            : context(&_context), value(_context.fromModNum(num)) {}
+
+        /**
+         * @brief Getter for the value.
+         * @return The value in usual form, one REDC.
+         */
+        T getValue() const { return context->fromMontgomery(value); }
+
+        /**
+         * @brief Getter for the value in Montgomery form.
+         * @return value * R mod MOD.
+         */
+        const T &getForm() const { return value; }
+
+        /**
+         * @brief Getter for the modulus value.
+         * @return The modulus of the context.
+         */
+        T getMod() const { return context->getMod(); }
+
+        /**
+         * @brief Getter for the context.
+         * @return The context the number is bound to.
+         */
+        const MontgomeryContext<T> &getContext() const { return *context; }
+
+        /**
+         * @brief Converts the number to a modNum.
+         * @return The equal modNum.
+         */
+        modNum<T> toModNum() const { return context->toModNum(value); }
+
+        bool operator==(const montgomeryNum &other) const { return value == other.value; }
+        bool operator!=(const montgomeryNum &other) const { return value != other.value; }
+
+        /**
+         * @brief Calculates the inverse of the number.
+         * @return The inverse of the number.
+         * @throws std::invalid_argument if the inverse does not exist.
+         */
+        montgomeryNum inv() const;
+
+        /**
+         * @brief In-place addition operator.
+         * @param other The number to add.
+         * @return Reference to this number.
+         */
+        montgomeryNum &operator+=(const montgomeryNum &other);
+        /**
+         * @brief In-place subtraction operator.
+         * @param other The number to subtract.
+         * @return Reference to this number.
+         */
+        montgomeryNum &operator-=(const montgomeryNum &other);
+        /**
+         * @brief In-place multiplication operator, one REDC.
+         * @param other The number to multiply.
+         * @return Reference to this number.
+         */
+        montgomeryNum &operator*=(const montgomeryNum &other);
+        /**
+         * @brief In-place division operator.
+         * @param other The number to divide by.
+         * @return Reference to this number.
+         * @throws std::invalid_argument if the inverse does not exist.
+         */
+        montgomeryNum &operator/=(const montgomeryNum &other) { return *this *= other.inv(); }
+
+        montgomeryNum operator+(const montgomeryNum &other) const { return montgomeryNum(*this) += other; }
+        montgomeryNum operator-(const montgomeryNum &other) const { return montgomeryNum(*this) -= other; }
+        montgomeryNum operator*(const montgomeryNum &other) const { return montgomeryNum(*this) *= other; }
+        montgomeryNum operator/(const montgomeryNum &other) const { return montgomeryNum(*this) /= other; }
+
+        template <typename T1>
+        friend montgomeryNum<T1> fpow(montgomeryNum<T1> value, T1 power);
+    };
+
+    /**
+     * @brief A ring of residues modulo a fixed modulus.
+     * The ring owns the modulus and its precomputations, elements are plain residues
+     * of type T in range [0, MOD), so containers of elements store one value per entry.
+     * The modulus is validated once, in the constructor. Element operations expect reduced
+     * residues, never check the modulus again and are noexcept and branch-free for built-in
+     * types; modNum remains the checked interface.
+     * @tparam T The type of value in the modular number.
+     */
+    template <typename T>
+    class modRing
+    {
+    private:
+        T MOD;
+        typename reducerType<T>::type reducer;
+
+        /**
+         * @brief Element operations on built-in types cannot fail once the modulus is validated.
+         */
+        static constexpr bool nothrowOps = std::is_integral<T>::value;
+
+    public:
+        /**
+         * @brief Constructor for the modRing class.
+         * @param _MOD The modulus value.
+         * @throws std::invalid_argument if modulus is not positive.
+         */
+        explicit modRing(T _MOD);
+
+        /**
+         * @brief Getter for the modulus value.
+         * @return The modulus of the ring.
+         */
+        T getMod() const { return MOD; }
+
+        /**
+         * @brief Maps an arbitrary value to its residue.
+         * @param value The value.
+         * @return value mod MOD in range [0, MOD).
+         */
+        T element(T value) const noexcept(nothrowOps);
+
+        /**
+         * @brief Addition of two residues.
+         * @param value1 The first residue.
+         * @param value2 The second residue.
+         * @return The sum modulo MOD.
+         */
+        T add(const T &value1, const T &value2) const noexcept(nothrowOps);
+
+        /**
+         * @brief Subtraction of two residues.
+         * @param value1 The first residue.
+         * @param value2 The second residue.
+         * @return The difference modulo MOD.
+         */
+        T subs(const T &value1, const T &value2) const noexcept(nothrowOps);
+
+        /**
+         * @brief Multiplication of two residues.
+         * @param value1 The first residue.
+         * @param value2 The second residue.
+         * @return The product modulo MOD.
+         */
+        T mult(const T &value1, const T &value2) const noexcept(nothrowOps);
+
+        /**
+         * @brief Calculates the inverse of a residue.
+         * @param value The residue.
+         * @return The inverse modulo MOD.
+         * @throws std::invalid_argument if the inverse does not exist.
+         */
+        T inv(const T &value) const;
+
+        /**
+         * @brief Division of two residues.
+         * @param value1 The numerator.
+         * @param value2 The denominator.
+         * @return The result of the division modulo MOD.
+         */
+        T div(const T &value1, const T &value2) const { return mult(value1, inv(value2)); }
+
+        /**
+         * @brief Raises a residue to a non-negative power.
+         * @param value The residue.
+         * @param power The power.
+         * @return value^power modulo MOD.
+         */
+        T pow(T value, T power) const;
+
+        /**
+         * @brief Converts a modNum with the same modulus to a residue.
+         * @param num The modNum.
+         * @return The residue of num.
+         * @throws std::invalid_argument if moduli differ.
+         */
+        T fromModNum(const modNum<T> &num) const;
+
+        /**
+         * @brief Converts a residue to a modNum.
+         * @param value The residue.
+         * @return The modNum with the modulus of the ring.
+         */
+        modNum<T> toModNum(const T &value) const noexcept(nothrowOps) { return modNum<T>(value, MOD, reducedTag()); }
+
+        /**
+         * @brief In-place addition, value1 = value1 + value2.
+         * @param value1 The residue to update.
+         * @param value2 The residue to add.
+         */
+        void addAssign(T &value1, const T &value2) const noexcept(nothrowOps);
+
+        /**
+         * @brief In-place subtraction, value1 = value1 - value2.
+         * @param value1 The residue to update.
+         * @param value2 The residue to subtract.
+         */
+        void subsAssign(T &value1, const T &value2) const noexcept(nothrowOps);
+
+        /**
+         * @brief In-place multiplication, value1 = value1 * value2.
+         * @param value1 The residue to update.
+         * @param value2 The residue to multiply by.
+         */
+        void multAssign(T &value1, const T &value2) const noexcept(nothrowOps);
+    };
+
+    /**
+     * @brief Fixed-base exponentiation with a precomputed Lim-Lee comb.
+     * The exponent is split into `teeth` rows of `spacing` bits; the table holds the
+     * 2^teeth products of base^(2^(j * spacing)), so pow costs spacing squarings and
+     * at most spacing multiplications. The object is immutable after construction
+     * and can be shared read-only between threads.
+     * @tparam T The type of value in the modular number.
+     */
+    template <typename T>
+    class fixedBasePow
+    {
+    private:
+        modRing<T> ring;
+        T base;
+        size_t teeth, spacing;
+        std::vector<T> table;
+
+    public:
+        /**
+         * @brief Builds the comb table for a base.
+         * @param _base The base.
+         * @param maxBits The longest exponent answered from the table, 0 for the bit length of the modulus.
+         * @param _teeth The number of comb teeth, the table holds 2^_teeth residues.
+         * @throws std::invalid_argument if _teeth is not in range [1, 16].
+         */
+        explicit fixedBasePow(const modNum<T> &_base, size_t maxBits = 0, size_t _teeth = 6);
+
+        /**
+         * @brief Getter for the longest exponent answered from the table.
+         * @return The maximal exponent bit length.
+         */
+        size_t getMaxBits() const { return teeth * spacing; }
+
+        /**
+         * @brief Getter for the number of precomputed residues.
+         * @return The size of the comb table.
+         */
+        size_t getTableSize() const { return table.size(); }
+
+        /**
+         * @brief Raises the base to a non-negative power.
+         * Longer exponents fall back to fpow.
+         * @param power The power value.
+         * @return base^power.
+         * @throws std::invalid_argument for 0 pow 0.
+         */
+        modNum<T> pow(const T &power) const;
+    };
+
+    /**
+     * @brief A modular number whose modulus is a compile-time constant.
+     * Reduction constants are computed at compile time: moduli of the form 2^k - c
+     * with small c (Mersenne and pseudo-Mersenne primes) are reduced with shifts and adds,
+     * moduli below 2^32 with a division by a constant, others with a constexpr Barrett reducer.
+     * @tparam T The built-in type of the value.
+     * @tparam MOD The modulus, 0 < MOD < 2^63.
+     */
+    template <typename T, T MOD>
+    class fixedModNum
+    {
+        static_assert(std::is_integral<T>::value, "compile-time modulus should be a built-in integer");
+        static_assert(MOD > 0 && static_cast<unsigned long long>(MOD) < (1ULL << 63),
+                      "compile-time modulus should be in range (0, 2^63)");
+
+    private:
+        T value;
+
+        /**
+         * @brief Number of bits in MOD.
+         * @return k such that 2^(k-1) <= MOD < 2^k.
+         */
+        static constexpr size_t modBits();
+
+        /**
+         * @brief Checks if MOD = 2^k - c with c < 2^(k/2).
+         * @return True if shift-and-add reduction applies.
+         */
+        static constexpr bool isPseudoMersenne();
+
+        /**
+         * @brief Reduces a product of two residues modulo MOD.
+         * @param x The value to reduce, x < MOD^2.
+         * @return x mod MOD.
+         */
+        static constexpr uint64_t reduce(unsigned __int128 x);
+
+    public:
+        /**
+         * @brief Constructor for the fixedModNum class.
+         * @param _value The initial value.
+         */
+        constexpr fixedModNum(T _value = 0);
+
+        /**
+         * @brief Getter for the value.
+         * @return The current value.
+         */
+        constexpr T getValue() const { return value; }
+
+        /**
+         * @brief Getter for the modulus value.
+         * @return The compile-time modulus.
+         */
+        static constexpr T getMod() { return MOD; }
+
+        /**
+         * @brief Setter for the value.
+         * @param value The new value to be set.
+         */
+        void setValue(T _value) { *this = fixedModNum(_value); }
+
+        /**
+         * @brief Converts the number to a modNum with a runtime modulus.
+         * @return The equal modNum.
+         */
+        modNum<T> toModNum() const { return modNum<T>(value, MOD); }
+
+        bool operator==(const fixedModNum &other) const { return value == other.value; }
+        bool operator!=(const fixedModNum &other) const { return value != other.value; }
+        bool operator<(const fixedModNum &other) const { return value < other.value; }
+        bool operator<=(const fixedModNum &other) const { return value <= other.value; }
+        bool operator>(const fixedModNum &other) const { return value > other.value; }
+        bool operator>=(const fixedModNum &other) const { return value >= other.value; }
+
+        /**
+         * @brief Calculates the inverse of the number.
+         * @return The inverse of the number.
+         * @throws std::invalid_argument if the inverse does not exist.
+         */
+        fixedModNum inv() const;
+
+        /**
+         * @brief Addition operator.
+         * @param other The number to add.
+         * @return The result of the addition.
+         */
+        constexpr fixedModNum operator+(const fixedModNum &other) const;
+        /**
+         * @brief Subtraction operator.
+         * @param other The number to subtract.
+         * @return The result of the subtraction.
+         */
+        constexpr fixedModNum operator-(const fixedModNum &other) const;
+        /**
+         * @brief Multiplication operator.
+         * @param other The number to multiply.
+         * @return The result of the multiplication.
+         */
+        constexpr fixedModNum operator*(const fixedModNum &other) const;
+        /**
+         * @brief Division operator.
+         * @param other The number to divide by.
+         * @return The result of the division.
+         */
+        fixedModNum operator/(const fixedModNum &other) const { return *this * other.inv(); }
+    };
+
+    /**
+     * @brief Iterative extended Euclidean algorithm.
+     * Long arithmetic values are passed to mpz_gcdext (Lehmer / half-gcd inside GMP).
+     * @param a The first value.
+     * @param b The second value.
+     * @param x The coefficient of a.
+     * @param y The coefficient of b.
+     * @return The GCD g of a and b, a * x + b * y = g.
+     */
+    template <typename T>
+    T extendedGcd(const T &a, const T &b, T &x, T &y);
+
+    /**
+     * @brief Calculates the inverse of a value modulo mod.
+     * Built-in types run the iterative algorithm in signed 128-bit arithmetic,
+     * long arithmetic values are passed to mpz_invert.
+     * @param value The value in range [0, mod).
+     * @param mod The positive modulus value.
+     * @return The inverse value modulo mod.
+     * @throws std::invalid_argument if the inverse does not exist.
+     */
+    template <typename T>
+    T modInverse(const T &value, const T &mod);
+
+    /**
+     * @brief Inverts many residues modulo one modulus at once (Montgomery's trick).
+     * Costs one modular inversion and 3(n - 1) multiplications. Values that are not
+     * invertible are reported instead of throwing and come back reduced modulo mod.
+     * @param values Pointer to the residues, replaced by their inverses.
+     * @param size The number of residues.
+     * @param mod The positive modulus value.
+     * @return Flags, false for every value that has no inverse.
+     */
+    template <typename T>
+    std::vector<bool> batchInverse(T *values, size_t size, const T &mod);
+
+    /**
+     * @brief Inverts a vector of residues modulo one modulus at once.
+     * @param values The residues, replaced by their inverses.
+     * @param mod The positive modulus value.
+     * @return Flags, false for every value that has no inverse.
+     */
+    template <typename T>
+    std::vector<bool> batchInverse(std::vector<T> &values, const T &mod);
+
+    /**
+     * @brief Raises many bases to powers modulo one modulus on a pool of worker threads.
+     * The modulus is validated and its reduction context is built once for the whole batch.
+     * @param bases The bases.
+     * @param powers One non-negative exponent per base, or a single exponent for all bases.
+     * @param mod The positive modulus value.
+     * @param threads The number of workers, 0 for one per hardware thread.
+     * @return The residues base^power in the order of bases.
+     * @throws std::invalid_argument if the modulus is not positive, the number of powers
+     * does not match or a base and its power are both zero.
+     */
+    template <typename T>
+    std::vector<T> batchPow(const std::vector<T> &bases, const std::vector<T> &powers, const T &mod,
+                            size_t threads = 0);
+
+    /**
+     * @brief xoshiro256++ pseudo-random generator.
+     * Satisfies UniformRandomBitGenerator, so it can drive the standard distributions.
+     * The state is seeded from one 64-bit value through splitmix64.
+     */
+    class randomGenerator
+    {
+    private:
+        uint64_t state[4];
+
+    public:
+        using result_type = uint64_t;
+
+        /**
+         * @brief Constructor for the randomGenerator class.
+         * @param seed The seed value.
+         */
+        explicit randomGenerator(uint64_t seed = 0) { this->seed(seed); }
+
+        /**
+         * @brief Restarts the sequence from a seed.
+         * @param seed The seed value.
+         */
+        inline void seed(uint64_t seed) noexcept;
+
+        /**
+         * @brief Produces the next 64 random bits.
+         * @return A uniformly distributed 64-bit value.
+         */
+        inline uint64_t operator()() noexcept;
+
+        static constexpr uint64_t min() { return 0; }
+        static constexpr uint64_t max() { return UINT64_MAX; }
+    };
+
+    /**
+     * @brief Returns the generator of the calling thread.
+     * Each thread gets its own generator on first use, seeded from the library seed
+     * and the order in which threads first asked for one. Chunks run by the library's
+     * worker pool reseed it from the caller's generator and the chunk index instead,
+     * so threaded searches repeat their draws after setRandomSeed.
+     */
+    inline randomGenerator &threadRandom();
+
+    /**
+     * @brief Sets the library seed and reseeds the generator of the calling thread.
+     * Threads that have not used their generator yet derive their seeds from it.
+     * @param seed The seed value.
+     */
+    inline void setRandomSeed(uint64_t seed);
+
+    /**
+     * @brief Draws a uniform value in range [0, bound) from the thread generator.
+     * @param bound The exclusive upper bound.
+     * @return A uniformly distributed value.
+     * @throws std::invalid_argument if bound is not positive.
+     */
+    template <typename T>
+    T randomBelow(const T &bound);
+
+    /**
+     * @brief Draws a uniform value in range [low, high] from the thread generator.
+     * @param low The inclusive lower bound.
+     * @param high The inclusive upper bound.
+     * @return A uniformly distributed value.
+     * @throws std::invalid_argument if low is greater than high.
+     */
+    template <typename T>
+    T randomRange(const T &low, const T &high);
+
+    /**
+     * @brief Instruction sets used by the bulk array kernels.
+     */
+    enum class simdLevel
+    {
+        scalar,
+        avx2,
+        avx512
+    };
+
+    /**
+     * @brief Returns the instruction set used by the bulk kernels.
+     * Detected once from the running CPU unless capped by setSimdLevel.
+     */
+    inline simdLevel getSimdLevel();
+
+    /**
+     * @brief Caps the instruction set used by the bulk kernels.
+     * @param level The wanted level, lowered to what the CPU supports.
+     */
+    inline void setSimdLevel(simdLevel level);
+
+    /**
+     * @brief Adds two arrays of residues element-wise.
+     * Inputs must be reduced, result may alias an input. Vectorized for moduli below 2^31.
+     * @param result Pointer to the output array.
+     * @param a Pointer to the first array.
+     * @param b Pointer to the second array.
+     * @param size The number of elements.
+     * @param mod The modulus value.
+     */
+    inline void bulkAdd(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod);
+
+    /**
+     * @brief Subtracts two arrays of residues element-wise.
+     * Inputs must be reduced, result may alias an input. Vectorized for moduli below 2^31.
+     */
+    inline void bulkSubs(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod);
+
+    /**
+     * @brief Multiplies two arrays of residues element-wise.
+     * Vectorized with Montgomery multiplication for odd moduli below 2^31.
+     */
+    inline void bulkMult(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod);
+
+    /**
+     * @brief Computes a[i] * b[i] + c[i] element-wise.
+     * @param c Pointer to the addends, may be null.
+     */
+    inline void bulkMultAdd(uint32_t *result, const uint32_t *a, const uint32_t *b, const uint32_t *c, size_t size,
+                            uint32_t mod);
+
+    /**
+     * @brief Multiplies an array of residues by one scalar.
+     * @param scalar The factor, reduced by the function.
+     */
+    inline void bulkScale(uint32_t *result, const uint32_t *a, uint32_t scalar, size_t size, uint32_t mod);
+
+    /**
+     * @brief Computes the dot product of two arrays of residues.
+     * @return Sum of a[i] * b[i] modulo mod.
+     */
+    inline uint32_t bulkDot(const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod);
+
+    /**
+     * @brief 64-bit versions of the bulk kernels.
+     * Addition and subtraction are vectorized for moduli below 2^62 (2^63 with AVX-512),
+     * products go through a Barrett reducer.
+     */
+    inline void bulkAdd(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod);
+    inline void bulkSubs(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod);
+    inline void bulkMult(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod);
+    inline void bulkMultAdd(uint64_t *result, const uint64_t *a, const uint64_t *b, const uint64_t *c, size_t size,
+                            uint64_t mod);
+    inline void bulkScale(uint64_t *result, const uint64_t *a, uint64_t scalar, size_t size, uint64_t mod);
+    inline uint64_t bulkDot(const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod);
+
+    /**
+     * @brief Computes the power of a modNum value to a given base modNum.
+     * @param value The value to be raised to the power.
+     * @param base The base value.
+     * @param MOD The modulus value.
+     * @return The result of raising value to the power of base modulo MOD.
+     */
+    template <typename T1>
+    modNum<T1> pow(modNum<T1> value, modNum<T1> base, modNum<T1> MOD);
+
+    /**
+     * @brief Exponentiation engines selectable in fpow.
+     * classic runs square-and-multiply on modNum products (Barrett for word sizes),
+     * montgomery keeps the whole ladder in Montgomery form,
+     * automatic picks the faster one for the modulus.
+     */
+    enum class powEngine
+    {
+        classic,
+        montgomery,
+        automatic
+    };
+
+    /**
+     * @brief Computes the fast power of a modNum value to a given degree.
+     * @param value The value to be raised to the power.
+     * @param degree The degree value.
+     * @param engine The exponentiation engine.
+     * @return The result of raising value to the power of degree.
+     */
+    template <typename T1>
+    modNum<T1> fpow(modNum<T1> value, T1 degree, powEngine engine = powEngine::automatic);
+
+    /**
+     * @brief Computes the fast power of a number with a compile-time modulus.
+     * @param value The value to be raised to the power.
+     * @param power The degree value.
+     * @return The result of raising value to the power of degree.
+     */
+    template <typename T, T MOD>
+    fixedModNum<T, MOD> fpow(fixedModNum<T, MOD> value, T power);
+
+    /**
+     * @brief Computes the fast power of a number bound to a Montgomery context.
+     * The sliding-window ladder runs on the Montgomery form without conversions.
+     * @param value The value to be raised to the power.
+     * @param power The non-negative degree value.
+     * @return The result of raising value to the power of degree.
+     * @throws std::invalid_argument for 0 pow 0.
+     */
+    template <typename T>
+    montgomeryNum<T> fpow(montgomeryNum<T> value, T power);
+
+    /**
+     * @brief Computes the fast power of a modNum value using Montgomery multiplication.
+     * Falls back to the classic engine for moduli a MontgomeryContext does not support.
+     * @param value The value to be raised to the power.
+     * @param power The power value.
+     * @return The result of raising value to the power using Montgomery multiplication.
+     */
+    template <typename T>
+    modNum<T> fpowMontgomery(modNum<T> value, T power);
+
+    /**
+     * @brief Computes the product of several powers, b1^e1 * b2^e2 * ... * bk^ek.
+     * All powers share one squaring chain (Straus/Shamir trick with interleaved sliding windows),
+     * so the cost is about one exponentiation plus a multiplication per window of every term.
+     * @param terms The (base, exponent) pairs, bases share one modulus, exponents are non-negative.
+     * @return The product of the powers.
+     * @throws std::invalid_argument if terms is empty, moduli differ or a term is 0 pow 0.
+     */
+    template <typename T>
+    modNum<T> multiPow(const std::vector<std::pair<modNum<T>, T>> &terms);
+
+    /**
+     * @brief Factorizes a modNum value using the Pollard algorithm.
+     * @param value The value to factorize.
+     * @return A vector of factorized modNum values in ascending order.
+     */
+    template <typename T1>
+    std::vector<modNum<T1>> factorize(modNum<T1> value);
+
+    /**
+     * @brief Factorizes a modNum value using the naive algorithm.
+     * @param value The value to factorize.
+     * @return A vector of factorized modNum values.
+     */
+    template <typename T1>
+    std::vector<modNum<T1>> naiveFactorize(modNum<T1> value);
+
+    /**
+     * @brief Factorizes a modNum value using the elliptic curve method.
+     * @param value The value to factorize.
+     * @param threads The number of worker threads, 0 for one per hardware thread.
+     * @return A vector of factorized modNum values.
+     */
+    template <typename T1>
+    std::vector<modNum<T1>> ecmFactorize(modNum<T1> value, size_t threads = 0);
+
+    /**
+     * @brief Factorizes a modNum value using the self-initializing quadratic sieve.
+     * @param value The value to factorize.
+     * @param threads The number of worker threads, 0 for one per hardware thread.
+     * @return A vector of factorized modNum values.
+     */
+    template <typename T1>
+    std::vector<modNum<T1>> siqsFactorize(modNum<T1> value, size_t threads = 0);
+
+    /**
+     * @brief Factorizes a modNum value using Pollard's p - 1 method.
+     * @param value The value to factorize.
+     * @param B1 The stage 1 bound; stage 2 goes up to 100 * B1.
+     * @return A vector of factorized modNum values.
+     */
+    template <typename T1>
+    std::vector<modNum<T1>> pm1Factorize(modNum<T1> value, uint64_t B1 = 100000);
+
+    /**
+     * @brief Factorizes a modNum value using Williams' p + 1 method.
+     * @param value The value to factorize.
+     * @param B1 The stage 1 bound; stage 2 goes up to 100 * B1.
+     * @return A vector of factorized modNum values.
+     */
+    template <typename T1>
+    std::vector<modNum<T1>> pp1Factorize(modNum<T1> value, uint64_t B1 = 100000);
+
+    /**
+     * @brief Thread-safe, size-bounded cache of complete factorizations.
+     * Numbers and their primes are kept as little-endian byte strings, so every integer
+     * type shares the same entries. The least recently used entry is dropped once the
+     * capacity is reached.
+     */
+    class factorCache
+    {
+    private:
+        using bytes = std::string;
+        using entry = std::pair<bytes, std::vector<std::pair<bytes, unsigned>>>;
+
+        mutable std::mutex lock;
+        size_t capacity;
+        std::list<entry> items;
+        std::unordered_map<bytes, std::list<entry>::iterator> index;
+
+        void put(bytes key, std::vector<std::pair<bytes, unsigned>> factors);
+
+    public:
+        /**
+         * @brief Constructor for the factorCache class.
+         * @param _capacity The largest number of factorizations kept.
+         */
+        explicit factorCache(size_t _capacity = 4096) : capacity(_capacity) {}
+
+        /**
+         * @brief Looks up the factorization of a number and marks it as recently used.
+         * @param n The number.
+         * @param factors Receives the prime to exponent map on a hit.
+         * @return True if the number is cached.
+         */
+        template <typename T>
+        bool lookup(const T &n, std::map<T, unsigned> &factors);
+
+        /**
+         * @brief Stores the complete factorization of a number.
+         * @param n The number.
+         * @param factors The prime to exponent map of n.
+         */
+        template <typename T>
+        void insert(const T &n, const std::map<T, unsigned> &factors);
+
+        /**
+         * @brief Returns the number of cached factorizations.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Changes the capacity, dropping the least recently used entries if needed.
+         * @param _capacity The largest number of factorizations kept.
+         */
+        void setCapacity(size_t _capacity);
+
+        /**
+         * @brief Removes every entry.
+         */
+        void clear();
+
+        /**
+         * @brief Writes the cache to a binary file, least recently used entry first.
+         * @param path The file to write.
+         * @throws std::invalid_argument if the file can not be written.
+         */
+        void save(const std::string &path) const;
+
+        /**
+         * @brief Adds the entries of a file written by save.
+         * @param path The file to read.
+         * @throws std::invalid_argument if the file can not be read or is malformed.
+         */
+        void load(const std::string &path);
+    };
+
+    /**
+     * @brief Returns the cache consulted by the number-theoretic functions.
+     */
+    inline factorCache &sharedFactorCache();
+
+    /**
+     * @brief Factorizes a number through the shared cache.
+     * Misses are factored with Pollard's rho. Types narrower than 64 bits are factored by trial
+     * division and bypass the cache.
+     * @param n The number, at least 1.
+     * @return The prime to exponent map of n.
+     */
+    template <typename T>
+    std::map<T, unsigned> cachedFactorization(const T &n);
+
+    /**
+     * @brief Computes the square root of a modNum value.
+     * @param value The value to compute the square root.
+     * @return A vector of modNum values representing the square root.
+     */
+    template <typename T1>
+    std::vector<T1> sqrt(modNum<T1> value);
+
+    /**
+     * @brief Computes the square root of a number with a compile-time modulus.
+     * @param value The value to compute the square root.
+     * @return A vector of values representing the square root.
+     */
+    template <typename T, T MOD>
+    std::vector<T> sqrt(fixedModNum<T, MOD> value);
+
+    /**
+     * @brief Computes the discrete logarithm of a modNum value to a given base.
+     * @param value The value for which to compute the discrete logarithm.
+     * @param base The base value.
+     * @return The discrete logarithm of value with respect to base.
+     */
+    template <typename T1>
+    T1 log(modNum<T1> value, modNum<T1> base);
+
+    /**
+     * @brief Computes the discrete logarithm of a number with a compile-time modulus.
+     * @param value The value for which to compute the discrete logarithm.
+     * @param base The base value.
+     * @return The discrete logarithm of value with respect to base.
+     */
+    template <typename T, T MOD>
+    T log(fixedModNum<T, MOD> value, fixedModNum<T, MOD> base);
+
+    /**
+     * @brief Checks if a modNum value is a multiplicative group generator.
+     * @param value The value to check.
+     * @return True if the value is a generator, otherwise false.
+     */
+    template <typename T1>
+    bool isGenerator(modNum<T1> value);
+
+    /**
+     * @brief Computes the multiplicative order of a modNum value.
+     * @param value The value, its modulus must be prime.
+     * @return The smallest positive k with value^k = 1.
+     */
+    template <typename T1>
+    T1 orderOfElement(modNum<T1> value);
+
+    /**
+     * @brief Checks if a number with a compile-time modulus is a multiplicative group generator.
+     * @param value The value to check.
+     * @return True if the value is a generator, otherwise false.
+     */
+    template <typename T, T MOD>
+    bool isGenerator(fixedModNum<T, MOD> value);
+
+    /**
+     * @brief Computes the Euler's totient function of a modNum value.
+     * @param num The value for which to compute the Euler's totient function.
+     * @return The Euler's totient function value of num.
+     */
+    template <typename T>
+    modNum<T> eulerFunction(modNum<T> num);
+
+    /**
+     * @brief Computes the Carmichael function of a value.
+     * @param value The value for which to compute the Carmichael function.
+     * @return The Carmichael function value of value.
+     */
     template <typename T1>
     T1 carmichaelFunction(T1 value);
 
     /**
-     * @brief Performs the Miller-Rabin primality test on a modNum value.
+     * @brief Deterministic primality test of a modNum value (Miller-Rabin below 2^64, Baillie-PSW above).
      * @param value The value to test for primality.
-     * @param k The number of iterations for the test.
-     * @return True if value is likely prime, otherwise false.
+     * @param k Ignored, kept for compatibility with the former randomized test.
+     * @return True if value is prime, otherwise false.
      */
     template <typename T1>
     bool isPrime(modNum<T1> value, size_t k);
 
+    /**
+     * @brief Deterministic primality test of a plain value, with the same tests as isPrime.
+     * @param value The value to test for primality.
+     * @return True if value is prime, otherwise false.
+     */
+    template <typename T1>
+    bool isPrimeValue(const T1 &value);
+
+    /**
+     * @brief Cheap Pollard p - 1 pass run on multi-word values before the slower methods.
+     * @param n The number to split.
+     * @return A proper divisor of n, or 1.
+     */
+    inline mpz_class smoothFirstPass(const mpz_class &n);
+
+    /**
+     * @brief Common driver of the factorization strategies.
+     * Strips the small-prime table, stops at primes, splits perfect squares and passes
+     * multi-word composites to smoothFirstPass and then to search; word-sized values
+     * and failed searches fall back to Pollard's rho. Both parts are factored recursively.
+     * @param value The value to factorize, should be positive.
+     * @param search Called as search(mpz_class n), returns a proper divisor of n or 1.
+     * @param firstPass False to skip smoothFirstPass.
+     * @return A vector of factors.
+     * @throws std::invalid_argument if value is less than 1.
+     */
+    template <typename T, typename Search>
+    std::vector<T> smoothFactor(T value, const Search &search, bool firstPass = true);
+
+    /**
+     * @brief Outcome of the small-prime pre-filter.
+     */
+    enum class sieveVerdict
+    {
+        composite,
+        prime,
+        unknown
+    };
+
+    /**
+     * @brief Bound of the compile-time table of small primes, every prime below it is listed.
+     */
+    constexpr uint32_t smallPrimeBound = 1024;
+
+    /**
+     * @brief Rejects values with a prime factor below smallPrimeBound.
+     * Words are tested with one multiplication per prime, GMP integers with a gcd against the primorial.
+     * @param value The value to check.
+     * @return prime or composite when decided by the table, otherwise unknown.
+     */
+    template <typename T>
+    sieveVerdict smallPrimeFilter(const T &value);
+
+    /**
+     * @brief Divides out every prime factor below smallPrimeBound.
+     * @param value The value to reduce, should be positive.
+     * @param visit Called as visit(prime, exponent) for each prime factor found, in increasing order.
+     * @return The cofactor, free of prime factors below smallPrimeBound.
+     */
+    template <typename T, typename Visitor>
+    T stripSmallPrimes(T value, Visitor visit);
+
+    /**
+     * @brief Primes of a range [lo, hi), enumerated by a segmented sieve of Eratosthenes.
+     * Odd numbers are sieved one block at a time. Base primes up to max(2^16, 2 * block)
+     * are kept with their next multiple; larger base primes, up to sqrt(hi), are sieved
+     * again in segments once per window of largeBaseWindow odd numbers, and their hits
+     * are sorted into one bucket per block, so memory stays within the window.
+     * The range is single-pass: begin() restarts the enumeration.
+     */
+    class primeRange
+    {
+    private:
+        uint64_t lo, hi, limit, storedLimit;
+        size_t blockSize;
+        std::vector<uint32_t> basePrimes;
+        std::vector<uint64_t> nextMultiple;
+        std::vector<uint8_t> composite, baseBlock;
+        std::vector<std::vector<uint32_t>> buckets;
+        uint64_t blockLow, windowLow, windowHigh;
+        size_t position;
+        bool pendingTwo;
+
+        /**
+         * @brief Moves back to the start of the range.
+         */
+        inline void rewind();
+
+        /**
+         * @brief Sieves the block of odd numbers starting at low.
+         * @param low The first (odd) number of the block.
+         */
+        inline void sieveBlock(uint64_t low);
+
+        /**
+         * @brief Number of odd numbers that share one pass over the base primes above storedLimit,
+         * the window is also capped at 256 blocks.
+         */
+        static constexpr size_t largeBaseWindow = 1 << 22;
+
+        /**
+         * @brief Fills the buckets with the multiples of the base primes above storedLimit.
+         * @param low The first (odd) number of the window, the start of a block.
+         */
+        inline void sieveLargeBase(uint64_t low);
+
+        /**
+         * @brief Moves to the next prime of the range.
+         * @param prime Receives the prime.
+         * @return False if the range is exhausted.
+         */
+        inline bool advance(uint64_t &prime);
+
+    public:
+        /**
+         * @brief Input iterator over the primes of a range.
+         */
+        class iterator
+        {
+        private:
+            primeRange *range;
+            uint64_t value;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = uint64_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const uint64_t *;
+            using reference = const uint64_t &;
+
+            explicit iterator(primeRange *_range = nullptr) : range(_range), value(0)
+            {
+                if (range && !range->advance(value))
+                    range = nullptr;
+            }
+
+            const uint64_t &operator*() const { return value; }
+
+            iterator &operator++()
+            {
+                if (!range->advance(value))
+                    range = nullptr;
+                return *this;
+            }
+
+            bool operator==(const iterator &other) const
+            {
+                return range == other.range && (!range || value == other.value);
+            }
+            bool operator!=(const iterator &other) const { return !(*this == other); }
+        };
+
+        /**
+         * @brief Constructor for the primeRange class.
+         * @param _lo The inclusive lower bound.
+         * @param _hi The exclusive upper bound.
+         * @param blockBytes The size of one sieve block, by default an L1 data cache.
+         * @throws std::invalid_argument if hi exceeds 2^64 - 2^33 or blockBytes is zero.
+         */
+        inline primeRange(uint64_t _lo, uint64_t _hi, size_t blockBytes = 32768);
+
+        /**
+         * @brief Restarts the enumeration.
+         * @return An iterator to the first prime of the range.
+         */
+        iterator begin()
+        {
+            rewind();
+            return iterator(this);
+        }
+
+        iterator end() { return iterator(); }
+    };
+
+    /**
+     * @brief Counts the primes not exceeding n (Lucy Hedgehog's method, O(n^(3/4)) time, O(sqrt(n)) memory).
+     * @param n The bound.
+     * @return pi(n).
+     */
+    inline uint64_t primeCount(uint64_t n);
+
+    /**
+     * @brief Visits the prime factorization of a value found by trial division over the sieve.
+     * Table primes are divided out first; a prime cofactor is detected by isPrime
+     * instead of being divided up to its square root.
+     * @param value The value, should be positive.
+     * @param visit Called as visit(prime, exponent) for each prime factor, in increasing order.
+     */
+    template <typename T, typename Visitor>
+    void forEachPrimeFactor(T value, Visitor visit);
+
+    /**
+     * @brief Finds the smallest prime greater than a value.
+     * Candidates are sieved by the small-prime table in windows before the primality test.
+     * @param value The value.
+     * @return The next prime.
+     * @throws std::invalid_argument if the prime does not fit the type.
+     */
+    template <typename T>
+    T nextPrime(const T &value);
+
+    /**
+     * @brief Finds the largest prime less than a value.
+     * @param value The value.
+     * @return The previous prime.
+     * @throws std::invalid_argument if value is not greater than 2.
+     */
+    template <typename T>
+    T prevPrime(const T &value);
+
+    /**
+     * @brief Draws a random prime of an exact bit length from the thread generator.
+     * @param bits The bit length, at least 2.
+     * @return A prime in range [2^(bits - 1), 2^bits).
+     * @throws std::invalid_argument if bits is less than 2 or does not fit the type.
+     */
+    template <typename T>
+    T randomPrime(size_t bits);
+
+    /**
+     * @brief Tests many values for primality on a pool of threads.
+     * @param values The values to test.
+     * @param threads The number of worker threads, 0 for one per hardware thread.
+     * @return Entry i is true if values[i] is prime.
+     */
+    template <typename T>
+    std::vector<bool> isPrimeBatch(const std::vector<T> &values, size_t threads = 0);
+
+    /**
+     * @brief Tests every value of an interval [lo, hi) for primality.
+     * The interval is sieved by the small-prime table, survivors are tested on a pool of threads.
+     * @param lo The inclusive lower bound.
+     * @param hi The exclusive upper bound.
+     * @param threads The number of worker threads, 0 for one per hardware thread.
+     * @return Entry i is true if lo + i is prime.
+     */
+    template <typename T>
+    std::vector<bool> primeBitmap(const T &lo, const T &hi, size_t threads = 0);
+
 } // namespace modular
 #define MOD_NUM
 
+#include "source/barrett.tcc"
+#include "source/batch-inverse.tcc"
+#include "source/batch-pow.tcc"
+#include "source/ecm.tcc"
 #include "source/euler-carmichael.tcc"
+#include "source/factor-cache.tcc"
 #include "source/factorization.tcc"
+#include "source/fixed-base-pow.tcc"
+#include "source/fixed-mod-num.tcc"
 #include "source/fpow.tcc"
+#include "source/gcd.tcc"
 #include "source/isGenerator.tcc"
 #include "source/isPrime.tcc"
 #include "source/log.tcc"
+#include "source/mod-num-gmp.tcc"
 #include "source/mod-num.tcc"
+#include "source/mod-ring.tcc"
+#include "source/montgomery.tcc"
+#include "source/multi-pow.tcc"
+#include "source/orderOfElement.tcc"
+#include "source/parallel.tcc"
+#include "source/pollard-williams.tcc"
+#include "source/prime-search.tcc"
+#include "source/random.tcc"
+#include "source/sieve.tcc"
+#include "source/simd-kernels.tcc"
+#include "source/siqs.tcc"
+#include "source/small-primes.tcc"
 #include "source/sqrt.tcc"
 
 #endif
@@ -0,0 +1,64 @@
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef BARRETT_REDUCER
+#define BARRETT_REDUCER
+
+    /**
+     *  @brief Precomputes mu = floor((2^128 - 1) / MOD)
+     *  @param _MOD modulus
+     *  @throws invalid_argument if the modulus is zero
+     */
+    constexpr BarrettReducer::BarrettReducer(uint64_t _MOD)
+        : MOD(_MOD), mu(_MOD == 0 ? 0 : ~static_cast<unsigned __int128>(0) / _MOD)
+    {
+        if (MOD == 0)
+        {
+            throw std::invalid_argument("modulus should be positive");
+        }
+    }
+
+    /**
+     *  @brief Reduces x modulo MOD
+     *  @param x value to reduce
+     *
+     *  The quotient estimate drops the low partial products of x * mu,
+     *  so it is never above floor(x / MOD) and only a few units below it.
+     *
+     *  @return x mod MOD
+     */
+    constexpr uint64_t BarrettReducer::reduce(unsigned __int128 x) const noexcept
+    {
+        const uint64_t x0 = static_cast<uint64_t>(x), x1 = static_cast<uint64_t>(x >> 64);
+        const uint64_t m0 = static_cast<uint64_t>(mu), m1 = static_cast<uint64_t>(mu >> 64);
+
+        unsigned __int128 q = static_cast<unsigned __int128>(x1) * m1;
+        q += (static_cast<unsigned __int128>(x1) * m0) >> 64;
+        q += (static_cast<unsigned __int128>(x0) * m1) >> 64;
+
+        unsigned __int128 r = x - q * MOD;
+        while (r >= MOD)
+            r -= MOD;
+        return static_cast<uint64_t>(r);
+    }
+
+    inline const BarrettReducer &sharedReducer(uint64_t MOD)
+    {
+        thread_local BarrettReducer reducer(1);
+        if (reducer.getMod() != MOD)
+            reducer = BarrettReducer(MOD);
+        return reducer;
+    }
+
+    template <typename T>
+    typename reducerType<T>::type makeReducer(const T &MOD)
+    {
+        if constexpr (std::is_same<typename reducerType<T>::type, BarrettReducer>::value)
+            return BarrettReducer(static_cast<uint64_t>(MOD));
+        else
+            return noReducer();
+    }
+
+#endif
+} // namespace modular
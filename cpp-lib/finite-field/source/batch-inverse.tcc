@@ -0,0 +1,86 @@
+#include <vector>
+
+#include "../mod-math.h"
+#include "euler-carmichael.tcc"
+
+namespace modular
+{
+#ifndef BATCH_INVERSE
+#define BATCH_INVERSE
+
+    /**
+     *  @brief Multiplies all invertible values and remembers the prefix products
+     *  @param ring ring of the values
+     *  @param values residues
+     *  @param size number of residues
+     *  @param invertible flags of values taking part in the product
+     *  @param prefix prefix[i] is the product of the flagged values before i
+     *  @return product of all flagged values
+     */
+    template <typename T>
+    T batchPrefixProducts(const modRing<T> &ring, const T *values, size_t size,
+                          const std::vector<bool> &invertible, std::vector<T> &prefix)
+    {
+        T acc = ring.element(1);
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (!invertible[i])
+                continue;
+            prefix[i] = acc;
+            ring.multAssign(acc, values[i]);
+        }
+        return acc;
+    }
+
+    /**
+     *  @brief Inverts residues in place using one inversion
+     *  @param values residues, replaced by their inverses
+     *  @param size number of residues
+     *  @param mod modulus
+     *
+     *  If the product of all values is not invertible, every value is checked
+     *  with gcd, the bad ones are excluded and the product is rebuilt once.
+     *
+     *  Every value is reduced modulo mod first, so values without an inverse
+     *  come back as their residue.
+     *
+     *  @return flags, false for values without an inverse
+     */
+    template <typename T>
+    std::vector<bool> batchInverse(T *values, size_t size, const T &mod)
+    {
+        modRing<T> ring(mod);
+        std::vector<bool> invertible(size, true);
+        std::vector<T> prefix(size);
+
+        for (size_t i = 0; i < size; ++i)
+            values[i] = ring.element(values[i]);
+
+        T total = batchPrefixProducts(ring, values, size, invertible, prefix);
+        if (mygcd(total, mod) != 1)
+        {
+            for (size_t i = 0; i < size; ++i)
+                invertible[i] = mygcd(values[i], mod) == 1;
+            total = batchPrefixProducts(ring, values, size, invertible, prefix);
+        }
+
+        T acc = ring.inv(total);
+        for (size_t i = size; i-- > 0;)
+        {
+            if (!invertible[i])
+                continue;
+            T inverse = ring.mult(acc, prefix[i]);
+            ring.multAssign(acc, values[i]);
+            values[i] = inverse;
+        }
+        return invertible;
+    }
+
+    template <typename T>
+    std::vector<bool> batchInverse(std::vector<T> &values, const T &mod)
+    {
+        return batchInverse(values.data(), values.size(), mod);
+    }
+
+#endif
+} // namespace modular
@@ -0,0 +1,96 @@
+#include "../mod-math.h"
+#include "fpow.tcc"
+#include "parallel.tcc"
+
+namespace modular
+{
+#ifndef BATCH_POW
+#define BATCH_POW
+
+    /**
+     *  @brief Raises many bases to powers modulo one modulus
+     *  @param bases bases, reduced by the function
+     *  @param powers one exponent per base, or a single exponent shared by all bases
+     *  @param mod positive modulus
+     *  @param threads number of workers, 0 for one per hardware thread
+     *
+     *  The modulus is validated and its reduction context is built once, then read
+     *  by every worker. Word-size odd moduli use one MontgomeryContext, long ones
+     *  go through mpz_powm, other moduli through a modRing.
+     *
+     *  @return results in the order of bases
+     *  @throws invalid_argument if the modulus is not positive, the number of
+     *  powers does not match or some base and power are both zero
+     */
+    template <typename T>
+    std::vector<T> batchPow(const std::vector<T> &bases, const std::vector<T> &powers, const T &mod, size_t threads)
+    {
+        if (powers.size() != 1 && powers.size() != bases.size())
+        {
+            throw std::invalid_argument("number of powers should be 1 or match the number of bases");
+        }
+        modRing<T> ring(mod);
+        std::vector<T> results(bases.size());
+        auto powerAt = [&powers](size_t i) -> const T & { return powers.size() == 1 ? powers[0] : powers[i]; };
+        auto checkedBase = [&](size_t i)
+        {
+            T base = ring.element(bases[i]);
+            if (base == 0 && powerAt(i) == 0)
+            {
+                throw std::invalid_argument("0 pow 0 is undefined");
+            }
+            return base;
+        };
+
+        if constexpr (std::is_integral<T>::value)
+        {
+            if (MontgomeryContext<T>::supports(mod))
+            {
+                const MontgomeryContext<T> ctx(mod);
+                parallelFor(bases.size(), threads,
+                            [&](size_t begin, size_t end)
+                            {
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    T result = slidingWindowPow(ctx.toMontgomery(checkedBase(i)), powerAt(i),
+                                                                ctx.one(),
+                                                                [&ctx](T &a, const T &b) { a = ctx.mult(a, b); });
+                                    results[i] = ctx.fromMontgomery(result);
+                                }
+                            });
+                return results;
+            }
+        }
+        else if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            if (mod % 2 == 1)
+            {
+                parallelFor(bases.size(), threads,
+                            [&](size_t begin, size_t end)
+                            {
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    T base = checkedBase(i);
+                                    if (powerAt(i) < 0)
+                                        results[i] = ring.element(1);
+                                    else
+                                        mpz_powm(results[i].get_mpz_t(), base.get_mpz_t(), powerAt(i).get_mpz_t(),
+                                                 mod.get_mpz_t());
+                                }
+                            });
+                return results;
+            }
+        }
+
+        parallelFor(bases.size(), threads,
+                    [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            results[i] = slidingWindowPow(checkedBase(i), powerAt(i), ring.element(1),
+                                                          [&ring](T &a, const T &b) { ring.multAssign(a, b); });
+                    });
+        return results;
+    }
+
+#endif
+} // namespace modular
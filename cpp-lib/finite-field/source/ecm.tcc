@@ -0,0 +1,298 @@
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "../mod-math.h"
+#include "factorization.tcc"
+#include "parallel.tcc"
+#include "pollard-williams.tcc"
+#include "random.tcc"
+#include "sieve.tcc"
+
+namespace modular
+{
+#ifndef ECM_FACTOR
+#define ECM_FACTOR
+
+    /**
+     *  @brief Point of a Montgomery curve in projective (X : Z) coordinates
+     */
+    struct ecmPoint
+    {
+        mpz_class x, z;
+    };
+
+    /**
+     *  @brief Montgomery curve B y^2 = x^3 + A x^2 + x over Z/nZ
+     *
+     *  Only x-coordinates are kept, so points are added through their known difference.
+     *  The curve keeps its own temporaries; one instance is used by one thread.
+     */
+    class montgomeryCurve
+    {
+    private:
+        const mpz_class &n;
+        mpz_class a24, s, d, u, v, w;
+
+        void reduce(mpz_class &value) { mpz_mod(value.get_mpz_t(), value.get_mpz_t(), n.get_mpz_t()); }
+
+    public:
+        /**
+         *  @brief Builds the curve and its starting point from Suyama's parameter
+         *  @param _n modulus
+         *  @param sigma parameter, in range [6, n - 1]
+         *  @param start receives the starting point
+         *  @param factor receives gcd(16 u^3 v, n) if the curve constants are not invertible
+         *
+         *  With u = sigma^2 - 5 and v = 4 sigma the point (u^3 : v^3) lies on the curve with
+         *  (A + 2) / 4 = (v - u)^3 (3u + v) / (16 u^3 v), whose group order is divisible by 12.
+         */
+        montgomeryCurve(const mpz_class &_n, const mpz_class &sigma, ecmPoint &start, mpz_class &factor) : n(_n)
+        {
+            u = sigma * sigma - 5;
+            reduce(u);
+            v = 4 * sigma;
+            reduce(v);
+            start.x = u * u * u;
+            reduce(start.x);
+            start.z = v * v * v;
+            reduce(start.z);
+
+            w = v - u;
+            a24 = w * w * w * (3 * u + v);
+            reduce(a24);
+            s = 16 * start.x * v;
+            reduce(s);
+            if (mpz_invert(d.get_mpz_t(), s.get_mpz_t(), n.get_mpz_t()) == 0)
+            {
+                mpz_gcd(factor.get_mpz_t(), s.get_mpz_t(), n.get_mpz_t());
+                return;
+            }
+            factor = 1;
+            a24 *= d;
+            reduce(a24);
+        }
+
+        /**
+         *  @brief Doubling, result may alias p
+         */
+        void dbl(ecmPoint &result, const ecmPoint &p)
+        {
+            s = p.x + p.z;
+            s *= s;
+            reduce(s);
+            d = p.x - p.z;
+            d *= d;
+            reduce(d);
+            result.x = s * d;
+            reduce(result.x);
+            w = s - d;
+            u = a24 * w + d;
+            reduce(u);
+            result.z = w * u;
+            reduce(result.z);
+        }
+
+        /**
+         *  @brief Differential addition p + q from diff = p - q, result may alias any argument
+         */
+        void add(ecmPoint &result, const ecmPoint &p, const ecmPoint &q, const ecmPoint &diff)
+        {
+            u = (p.x - p.z) * (q.x + q.z);
+            v = (p.x + p.z) * (q.x - q.z);
+            s = u + v;
+            d = u - v;
+            s *= s;
+            reduce(s);
+            d *= d;
+            reduce(d);
+            u = diff.z * s;
+            v = diff.x * d;
+            reduce(u);
+            reduce(v);
+            result.x.swap(u);
+            result.z.swap(v);
+        }
+
+        /**
+         *  @brief Montgomery ladder, result may alias p
+         *  @param result receives k * p
+         *  @param k positive multiplier
+         *  @param p point
+         */
+        void mul(ecmPoint &result, uint64_t k, const ecmPoint &p)
+        {
+            ecmPoint base = p, r0 = p, r1;
+            dbl(r1, p);
+            for (int bit = 62 - __builtin_clzll(k); bit >= 0; --bit)
+            {
+                if ((k >> bit) & 1)
+                {
+                    add(r0, r1, r0, base);
+                    dbl(r1, r1);
+                }
+                else
+                {
+                    add(r1, r0, r1, base);
+                    dbl(r0, r0);
+                }
+            }
+            result = r0;
+        }
+    };
+
+    /**
+     *  @brief Runs one curve through both stages
+     *  @param n odd composite number without small factors
+     *  @param sigma curve parameter
+     *  @param B1 stage 1 bound
+     *  @param B2 stage 2 bound
+     *
+     *  Stage 1 multiplies the point by every maximal prime power up to B1. Stage 2 writes
+     *  each prime q in (B1, B2] as i * D +- j with j < D / 2 coprime to D and accumulates
+     *  X(iDQ) Z(jQ) - X(jQ) Z(iDQ), which vanishes modulo p exactly when q Q = 0 on the curve mod p.
+     *
+     *  @return gcd found by the curve, 1 or n if it failed
+     */
+    inline mpz_class ecmCurve(const mpz_class &n, const mpz_class &sigma, uint64_t B1, uint64_t B2)
+    {
+        ecmPoint q;
+        mpz_class g;
+        montgomeryCurve curve(n, sigma, q, g);
+        if (g != 1)
+            return g;
+
+        for (uint64_t p : primeRange(2, B1 + 1))
+        {
+            uint64_t power = p;
+            while (power <= B1 / p)
+                power *= p;
+            curve.mul(q, power, q);
+        }
+        mpz_gcd(g.get_mpz_t(), q.z.get_mpz_t(), n.get_mpz_t());
+        if (g != 1 || B2 <= B1)
+            return g;
+
+        const uint64_t D = B1 >= 1155 ? 2310 : 210;
+        std::vector<ecmPoint> baby(D / 4 + 1);
+        ecmPoint q2;
+        curve.dbl(q2, q);
+        baby[0] = q;
+        if (baby.size() > 1)
+            curve.add(baby[1], q2, q, q);
+        for (size_t k = 2; k < baby.size(); ++k)
+            curve.add(baby[k], baby[k - 1], q2, baby[k - 2]);
+
+        ecmPoint step, giant, previous;
+        curve.mul(step, D, q);
+        uint64_t index = (B1 + 1 + D / 2) / D;
+        if (index == 0)
+            index = 1;
+        curve.mul(giant, index * D, q);
+        if (index > 1)
+            curve.mul(previous, (index - 1) * D, q);
+
+        mpz_class accumulator = 1, term;
+        for (uint64_t prime : primeRange(B1 + 1, B2 + 1))
+        {
+            uint64_t wanted = (prime + D / 2) / D;
+            while (index < wanted)
+            {
+                ecmPoint next;
+                if (index == 1)
+                    curve.dbl(next, giant);
+                else
+                    curve.add(next, giant, step, previous);
+                previous.x.swap(giant.x);
+                previous.z.swap(giant.z);
+                giant.x.swap(next.x);
+                giant.z.swap(next.z);
+                index++;
+            }
+            uint64_t offset = prime > index * D ? prime - index * D : index * D - prime;
+            const ecmPoint &b = baby[offset / 2];
+            term = giant.x * b.z - b.x * giant.z;
+            accumulator *= term;
+            mpz_mod(accumulator.get_mpz_t(), accumulator.get_mpz_t(), n.get_mpz_t());
+        }
+        mpz_gcd(g.get_mpz_t(), accumulator.get_mpz_t(), n.get_mpz_t());
+        return g;
+    }
+
+    /**
+     *  @brief Searches for a factor with ECM, from small to large factor sizes
+     *  @param n odd composite number without small factors, not a perfect power of a prime
+     *  @param threads number of workers, 0 for one per hardware thread
+     *  @param maxDigits largest factor size to aim at
+     *
+     *  The levels follow the usual ECM tables: B1 and the number of curves that find a factor
+     *  of the given size with high probability. Curves of a level run in parallel and stop
+     *  as soon as one of them succeeds.
+     *
+     *  @return nontrivial factor of n, or 1 if none was found
+     */
+    inline mpz_class ecmFindFactor(const mpz_class &n, size_t threads, size_t maxDigits)
+    {
+        struct level
+        {
+            size_t digits;
+            uint64_t B1;
+            size_t curves;
+        };
+        static constexpr level schedule[] = {{15, 2000, 25},        {20, 11000, 90},    {25, 50000, 300},
+                                             {30, 250000, 700},     {35, 1000000, 1800}, {40, 3000000, 5100},
+                                             {45, 11000000, 10600}, {50, 43000000, 19300}};
+
+        mpz_class factor = 1;
+        std::atomic<bool> found(false);
+        std::mutex lock;
+        for (const level &current : schedule)
+        {
+            if (current.digits > maxDigits && current.digits != schedule[0].digits)
+                break;
+            parallelFor(current.curves, threads,
+                        [&](size_t begin, size_t end)
+                        {
+                            for (size_t curve = begin; curve < end && !found.load(); ++curve)
+                            {
+                                mpz_class sigma = randomRange<mpz_class>(6, n - 1);
+                                mpz_class g = ecmCurve(n, sigma, current.B1, 100 * current.B1);
+                                if (g != 1 && g != n)
+                                {
+                                    std::lock_guard<std::mutex> guard(lock);
+                                    if (!found.load())
+                                    {
+                                        factor = g;
+                                        found.store(true);
+                                    }
+                                }
+                            }
+                        });
+            if (found.load())
+                break;
+        }
+        return factor;
+    }
+
+    /**
+     *  @brief Factorization using the elliptic curve method
+     *  @param value number
+     *  @return vector of factors
+     */
+    template <typename T1>
+    template <typename T2>
+    std::vector<T2> modNum<T1>::ECM<T2>::factor(T2 value)
+    {
+        return smoothFactor(value, [this](const mpz_class &n) { return ecmFindFactor(n, threads, maxDigits); });
+    }
+
+    template <typename T1>
+    std::vector<modNum<T1>> ecmFactorize(modNum<T1> value, size_t threads)
+    {
+        typename modNum<T1>::template ECM<T1> strat(threads);
+        Adapter<T1> adapter(value.getValue(), value.getMod());
+        return adapter.factorizeMod(&strat);
+    }
+
+#endif
+} // namespace modular
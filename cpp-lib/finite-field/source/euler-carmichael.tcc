@@ -2,6 +2,7 @@
 #include <map>
 #include <vector>
 #include "../mod-math.h"
+#include "factor-cache.tcc"
 
 using namespace std;
 namespace modular
@@ -23,19 +24,8 @@ namespace modular
             throw logic_error("Euler totient function is not defiend on non Natural values");
 
         T res = n;
-
-        for (T p = static_cast<T>(2); p * p <= n; p += static_cast<T>(1))
-        {
-            if (n % p == static_cast<T>(0))
-            {
-                while (n % p == static_cast<T>(0))
-                    n /= p;
-                res -= res / p;
-            }
-        }
-
-        if (n > static_cast<T>(1))
-            res -= res / n;
+        for (const auto &[p, exponent] : cachedFactorization(n))
+            res -= res / p;
         return res;
     }
     /*
@@ -96,29 +86,14 @@ namespace modular
         if (n == static_cast<T>(1))
             return static_cast<T>(1);
         std::vector<T> factors;
-        for (T i = static_cast<T>(2); i * i <= n; i += static_cast<T>(2))
+        for (const auto &[p, exponent] : cachedFactorization(n))
         {
-            T w = static_cast<T>(0);
-            while (n % i == static_cast<T>(0))
-            {
-                w++;
-                n /= i;
-            }
-            if (i == static_cast<T>(2) && w >= static_cast<T>(3))
-            {
-                T power = myLogPow<T>(i, w - 1);
-                factors.push_back((power * (i - 1)) / 2);
-            }
-            else if (i >= 2 && w > 0)
-            {
-                T power = myLogPow<T>(i, w - 1);
-                factors.push_back(power * (i - 1));
-            }
-            if (i == 2)
-                i--;
+            T power = myLogPow<T>(p, static_cast<T>(exponent - 1));
+            if (p == static_cast<T>(2) && exponent >= 3)
+                factors.push_back((power * (p - 1)) / 2);
+            else
+                factors.push_back(power * (p - 1));
         }
-        if (n != 1)
-            factors.push_back(n - 1);
 
         T res = 1;
         for (auto i : factors)
@@ -0,0 +1,296 @@
+#include <fstream>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../mod-math.h"
+#include "factorization.tcc"
+#include "sieve.tcc"
+
+namespace modular
+{
+#ifndef FACTOR_CACHE
+#define FACTOR_CACHE
+
+    /**
+     *  @brief Encodes a positive integer as its little-endian bytes
+     */
+    template <typename T>
+    std::string factorCacheBytes(const T &value)
+    {
+        std::string result;
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            result.resize((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8);
+            size_t count = 0;
+            mpz_export(&result[0], &count, -1, 1, 0, 0, value.get_mpz_t());
+            result.resize(count);
+        }
+        else
+        {
+            for (T rest = value; rest > 0; rest >>= 8)
+                result.push_back(static_cast<char>(static_cast<unsigned char>(rest & 0xff)));
+        }
+        return result;
+    }
+
+    /**
+     *  @brief Decodes the little-endian bytes written by factorCacheBytes
+     */
+    template <typename T>
+    T factorCacheValue(const std::string &bytes)
+    {
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            T result;
+            mpz_import(result.get_mpz_t(), bytes.size(), -1, 1, 0, 0, bytes.data());
+            return result;
+        }
+        else
+        {
+            T result = 0;
+            for (size_t i = bytes.size(); i > 0; --i)
+                result = static_cast<T>((result << 8) | static_cast<unsigned char>(bytes[i - 1]));
+            return result;
+        }
+    }
+
+    /**
+     *  @brief Stores an entry as the most recently used one, replacing an older copy
+     */
+    inline void factorCache::put(bytes key, std::vector<std::pair<bytes, unsigned>> factors)
+    {
+        auto found = index.find(key);
+        if (found != index.end())
+        {
+            found->second->second = std::move(factors);
+            items.splice(items.begin(), items, found->second);
+            return;
+        }
+        if (capacity == 0)
+            return;
+        while (items.size() >= capacity)
+        {
+            index.erase(items.back().first);
+            items.pop_back();
+        }
+        items.emplace_front(std::move(key), std::move(factors));
+        index.emplace(items.front().first, items.begin());
+    }
+
+    template <typename T>
+    bool factorCache::lookup(const T &n, std::map<T, unsigned> &factors)
+    {
+        bytes key = factorCacheBytes(n);
+        std::lock_guard<std::mutex> guard(lock);
+        auto found = index.find(key);
+        if (found == index.end())
+            return false;
+        items.splice(items.begin(), items, found->second);
+        factors.clear();
+        for (const auto &[prime, exponent] : found->second->second)
+            factors.emplace(factorCacheValue<T>(prime), exponent);
+        return true;
+    }
+
+    template <typename T>
+    void factorCache::insert(const T &n, const std::map<T, unsigned> &factors)
+    {
+        std::vector<std::pair<bytes, unsigned>> encoded;
+        encoded.reserve(factors.size());
+        for (const auto &[prime, exponent] : factors)
+            encoded.emplace_back(factorCacheBytes(prime), exponent);
+        bytes key = factorCacheBytes(n);
+        std::lock_guard<std::mutex> guard(lock);
+        put(std::move(key), std::move(encoded));
+    }
+
+    inline size_t factorCache::size() const
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return items.size();
+    }
+
+    inline void factorCache::setCapacity(size_t _capacity)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        capacity = _capacity;
+        while (items.size() > capacity)
+        {
+            index.erase(items.back().first);
+            items.pop_back();
+        }
+    }
+
+    inline void factorCache::clear()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        items.clear();
+        index.clear();
+    }
+
+    /**
+     *  @brief Writes an unsigned value in 7-bit groups, low group first
+     */
+    inline void writeVarint(std::ostream &out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.put(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.put(static_cast<char>(value));
+    }
+
+    /**
+     *  @brief Reads a value written by writeVarint
+     *  @throws invalid_argument if the stream ends early or the value does not fit 64 bits
+     */
+    inline uint64_t readVarint(std::istream &in)
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            int c = in.get();
+            if (c == std::char_traits<char>::eof())
+                throw std::invalid_argument("factor cache file is truncated");
+            value |= static_cast<uint64_t>(c & 0x7f) << shift;
+            if ((c & 0x80) == 0)
+                return value;
+        }
+        throw std::invalid_argument("factor cache file is malformed");
+    }
+
+    inline const char factorCacheMagic[] = "FCACHE1";
+
+    /**
+     *  @brief Writes the cache to a binary file
+     *  @param path file to write
+     *
+     *  The file holds the magic string, the entry count and, per entry, the number
+     *  and the primes as length-prefixed byte strings with varint exponents.
+     *  Entries go from the least to the most recently used, so load keeps the order.
+     */
+    inline void factorCache::save(const std::string &path) const
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            throw std::invalid_argument("can not open " + path + " for writing");
+
+        std::lock_guard<std::mutex> guard(lock);
+        out.write(factorCacheMagic, sizeof(factorCacheMagic));
+        writeVarint(out, items.size());
+        for (auto it = items.rbegin(); it != items.rend(); ++it)
+        {
+            writeVarint(out, it->first.size());
+            out.write(it->first.data(), static_cast<std::streamsize>(it->first.size()));
+            writeVarint(out, it->second.size());
+            for (const auto &[prime, exponent] : it->second)
+            {
+                writeVarint(out, prime.size());
+                out.write(prime.data(), static_cast<std::streamsize>(prime.size()));
+                writeVarint(out, exponent);
+            }
+        }
+        if (!out)
+            throw std::invalid_argument("can not write " + path);
+    }
+
+    /**
+     *  @brief Adds the entries of a file written by save
+     *  @param path file to read
+     *
+     *  The whole file is parsed before the cache is touched, so a malformed
+     *  file leaves the cache as it was.
+     */
+    inline void factorCache::load(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw std::invalid_argument("can not open " + path + " for reading");
+
+        char magic[sizeof(factorCacheMagic)];
+        if (!in.read(magic, sizeof(magic)) || std::char_traits<char>::compare(magic, factorCacheMagic, sizeof(magic)) != 0)
+            throw std::invalid_argument(path + " is not a factor cache file");
+
+        auto readBytes = [&in]()
+        {
+            uint64_t length = readVarint(in);
+            if (length > (static_cast<uint64_t>(1) << 24))
+                throw std::invalid_argument("factor cache file is malformed");
+            bytes result(length, '\0');
+            if (length > 0 && !in.read(&result[0], static_cast<std::streamsize>(length)))
+                throw std::invalid_argument("factor cache file is truncated");
+            return result;
+        };
+
+        std::vector<entry> loaded;
+        uint64_t count = readVarint(in);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            entry current;
+            current.first = readBytes();
+            uint64_t primes = readVarint(in);
+            for (uint64_t j = 0; j < primes; ++j)
+            {
+                bytes prime = readBytes();
+                uint64_t exponent = readVarint(in);
+                if (exponent == 0 || exponent > UINT32_MAX)
+                    throw std::invalid_argument("factor cache file is malformed");
+                current.second.emplace_back(std::move(prime), static_cast<unsigned>(exponent));
+            }
+            loaded.push_back(std::move(current));
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+        for (entry &current : loaded)
+            put(std::move(current.first), std::move(current.second));
+    }
+
+    inline factorCache &sharedFactorCache()
+    {
+        static factorCache cache;
+        return cache;
+    }
+
+    /**
+     *  @brief Factorizes a number through the shared cache
+     *  @param n number, at least 1
+     *
+     *  Types of 64 bits and more go through the cache and Pollard's rho like factorize.
+     *  Narrower types are done by trial division, which is quick at that size, and
+     *  bypass the cache so they neither take its lock nor evict the costly entries.
+     *
+     *  @return prime to exponent map of n
+     */
+    template <typename T>
+    std::map<T, unsigned> cachedFactorization(const T &n)
+    {
+        if (n < 1)
+            throw std::invalid_argument("value is less than 1");
+
+        std::map<T, unsigned> factors;
+        if constexpr (!std::is_same<T, mpz_class>::value && sizeof(T) < sizeof(uint64_t))
+        {
+            forEachPrimeFactor(n, [&factors](const T &p, unsigned exponent) { factors[p] += exponent; });
+            return factors;
+        }
+        else
+        {
+            factorCache &cache = sharedFactorCache();
+            if (cache.lookup(n, factors))
+                return factors;
+
+            typename modNum<T>::template Pollard<T> strat;
+            for (const T &p : strat.factor(n))
+                ++factors[p];
+            cache.insert(n, factors);
+            return factors;
+        }
+    }
+
+#endif
+} // namespace modular
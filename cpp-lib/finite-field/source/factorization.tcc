@@ -1,11 +1,13 @@
 #ifndef FACTOR
 #define FACTOR
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <string>
 
 #include "../mod-math.h"
+#include "sieve.tcc"
 
 using namespace std;
 using namespace modular;
@@ -19,42 +21,201 @@ using namespace modular;
 template <typename T1, typename T2>
 T2 gcd(T1 a, T2 b)
 {
-    return b == 0 ? a : gcd(b, a % b);
+    if constexpr (std::is_same<T1, mpz_class>::value && std::is_same<T2, mpz_class>::value)
+    {
+        mpz_class g;
+        mpz_gcd(g.get_mpz_t(), a.get_mpz_t(), b.get_mpz_t());
+        return g;
+    }
+    else
+    {
+        while (b != 0)
+        {
+            T2 r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
 }
 
 /**
  *  @brief Checks if the number is prime or not
  *  @param a first number
+ *
+ *  Trial division by the primes up to sqrt(a), taken from the segmented sieve.
+ *
  *  @return true or false
  */
 template <typename T1>
 bool isPrimeSimple(T1 a)
 {
-    for (int i = 2; i <= sqrt(a); ++i)
-        if (a % i == 0)
-            return false;
-    return true;
+    if constexpr (std::is_same<T1, mpz_class>::value)
+    {
+        mpz_class root = sqrt(a);
+        if (!root.fits_ulong_p())
+        {
+            for (mpz_class i = 2; i <= root; ++i)
+                if (a % i == 0)
+                    return false;
+            return true;
+        }
+        for (uint64_t p : primeRange(2, root.get_ui() + 1))
+            if (mpz_divisible_ui_p(a.get_mpz_t(), p))
+                return false;
+        return true;
+    }
+    else
+    {
+        if (a < 4)
+            return true;
+        uint64_t n = static_cast<uint64_t>(a);
+        for (uint64_t p : primeRange(2, integerSqrt(n) + 1))
+            if (n % p == 0)
+                return false;
+        return true;
+    }
 }
 
 /**
- *  @brief Calculating a polynomial in x computed modulo mod
- *  @param x value
- *  @param mod modulo
- *  @return polynomial in x computed modulo mod
+ *  @brief Montgomery arithmetic modulo an odd n < 2^127 on unsigned __int128
+ *
+ *  Residues stay in Montgomery form with R = 2^128. Rho only compares its values
+ *  and takes their gcd with n, neither of which changes under the factor R, so
+ *  the walk never converts back.
  */
-template <typename T1>
-T1 F(T1 x, T1 mod)
+class rhoMontgomery128
+{
+private:
+    using u128 = unsigned __int128;
+    u128 n, nPrime;
+
+    /**
+     *  @brief Full product of two 128-bit values
+     *  @param a first factor
+     *  @param b second factor
+     *  @param high receives the upper 128 bits
+     *  @param low receives the lower 128 bits
+     */
+    static void multFull(u128 a, u128 b, u128 &high, u128 &low)
+    {
+        u128 a0 = static_cast<uint64_t>(a), a1 = a >> 64, b0 = static_cast<uint64_t>(b), b1 = b >> 64;
+        u128 p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+        u128 middle = (p00 >> 64) + static_cast<uint64_t>(p01) + static_cast<uint64_t>(p10);
+        low = (middle << 64) | static_cast<uint64_t>(p00);
+        high = a1 * b1 + (p01 >> 64) + (p10 >> 64) + (middle >> 64);
+    }
+
+public:
+    /**
+     *  @brief Precomputes -n^-1 mod 2^128 by Newton iteration
+     *  @param _n odd modulus below 2^127
+     */
+    explicit rhoMontgomery128(u128 _n) : n(_n)
+    {
+        // n * n = 1 mod 8, every step doubles the number of correct bits
+        u128 x = n;
+        for (int i = 0; i < 6; ++i)
+            x *= 2 - n * x;
+        nPrime = -x;
+    }
+
+    void addAssign(u128 &value1, const u128 &value2) const
+    {
+        value1 += value2;
+        if (value1 >= n)
+            value1 -= n;
+    }
+
+    void subsAssign(u128 &value1, const u128 &value2) const
+    {
+        value1 = value1 >= value2 ? value1 - value2 : value1 + (n - value2);
+    }
+
+    /**
+     *  @brief Montgomery product, value1 = value1 * value2 / R mod n
+     *
+     *  The low half of t + m n is zero by the choice of m, so only its carry is kept;
+     *  n < 2^127 keeps the upper half below 2n without overflow.
+     */
+    void multAssign(u128 &value1, const u128 &value2) const
+    {
+        u128 high, low, mHigh, mLow;
+        multFull(value1, value2, high, low);
+        multFull(low * nPrime, n, mHigh, mLow);
+        value1 = high + mHigh + (low != 0);
+        if (value1 >= n)
+            value1 -= n;
+    }
+};
+
+/**
+ *  @brief One attempt of Pollard's rho with Brent's cycle detection
+ *  @param ring in-place arithmetic modulo n
+ *  @param n odd composite number
+ *  @param c constant of the polynomial x^2 + c
+ *  @param y starting value
+ *
+ *  Differences |x - y| are multiplied together over blocks of up to 128 steps,
+ *  so one gcd covers a whole block; when a block collapses to n, the last block
+ *  is replayed one step at a time. Every step updates preallocated registers in
+ *  place, so long values do not allocate inside the loop.
+ *
+ *  @return divisor of n, n itself if the attempt failed
+ */
+template <typename T1, typename Ring>
+T1 brentRho(const Ring &ring, const T1 &n, const T1 &c, T1 y)
 {
-    T1 a = rand() % 10;
-    return (x * x + (1 + 2 * a)) % mod;
+    const size_t block = 128;
+    auto step = [&ring, &c](T1 &value)
+    {
+        ring.multAssign(value, value);
+        ring.addAssign(value, c);
+    };
+
+    T1 x = y, ys = y, q = 1, d = 1, difference = 0;
+    for (size_t r = 1; d == 1; r *= 2)
+    {
+        x = y;
+        for (size_t i = 0; i < r; ++i)
+            step(y);
+        for (size_t k = 0; k < r && d == 1; k += block)
+        {
+            ys = y;
+            for (size_t i = 0; i < std::min(block, r - k); ++i)
+            {
+                step(y);
+                difference = x;
+                ring.subsAssign(difference, y);
+                ring.multAssign(q, difference);
+            }
+            d = ::gcd(q, n);
+        }
+    }
+
+    if (d == n)
+    {
+        // backtrack through the last block
+        do
+        {
+            step(ys);
+            difference = x;
+            ring.subsAssign(difference, ys);
+            d = ::gcd(difference, n);
+        } while (d == 1);
+    }
+    return d;
 }
 
 /**
- *  @brief Pollard's rho algorithm
- *  @param n number
+ *  @brief Pollard's rho algorithm with Brent's cycle detection
+ *  @param n odd composite number
  *
+ *  The walk x -> x^2 + c uses a random c and start per attempt, an attempt that
+ *  only finds n restarts with a new polynomial. Long values below 2^127 walk on
+ *  unsigned __int128 with Montgomery products, larger ones on GMP registers.
  *
- *  @return factor
+ *  @return nontrivial factor of n
  */
 template <typename T1>
 T1 pollardRhO(T1 n)
@@ -62,58 +223,80 @@ T1 pollardRhO(T1 n)
     if (n % 2 == 0)
         return 2;
 
-    T1 x = 2;
-    T1 y = 2;
-    T1 d = 1;
+    if constexpr (std::is_same<T1, mpz_class>::value)
+    {
+        if (mpz_sizeinbase(n.get_mpz_t(), 2) < 127)
+        {
+            using u128 = unsigned __int128;
+            uint64_t words[2] = {0, 0};
+            mpz_export(words, nullptr, -1, sizeof(uint64_t), 0, 0, n.get_mpz_t());
+            u128 m = (static_cast<u128>(words[1]) << 64) | words[0];
 
-    while (d == 1)
+            rhoMontgomery128 ring(m);
+            u128 d = m;
+            while (d == m)
+                d = brentRho(ring, m, randomRange<u128>(1, m - 3), randomRange<u128>(0, m - 1));
+
+            words[0] = static_cast<uint64_t>(d);
+            words[1] = static_cast<uint64_t>(d >> 64);
+            mpz_class divisor;
+            mpz_import(divisor.get_mpz_t(), 2, -1, sizeof(uint64_t), 0, 0, words);
+            return divisor;
+        }
+    }
+
+    modRing<T1> ring(n);
+    while (true)
     {
-        x = F(x, n);
-        y = F(F(y, n), n);
-        d = gcd(abs(x - y), n);
+        T1 d = brentRho(ring, n, randomRange<T1>(1, n - 3), randomRange<T1>(0, n - 1));
+        if (d != n)
+            return d;
     }
-    return d;
 }
 
 /**
- *  @brief Factorization using Pollard's rho algorithm
- *  @param value number
- *  @return vector of factors
+ *  @brief Square root of a perfect square
+ *  @param value positive number
+ *  @param root receives the square root when value is a perfect square
+ *
+ *  Rho needs about sqrt(p) steps to split p^2, the same as for p * q,
+ *  while a square is recognised at once.
+ *
+ *  @return true if value is a perfect square
  */
 template <typename T1>
-template <typename T2>
-std::vector<T2>
-modNum<T1>::Pollard<T2>::factor(T2 value)
+bool exactSquareRoot(const T1 &value, T1 &root)
 {
-    if (value < 1)
-        throw invalid_argument("value is less than 1");
-    else if (value == 1)
-        return vector<T2>{};
-    else if (isPrime(modNum<T2>(value, value + 1), 10))
-        return vector<T2>{value};
-
-    vector<T2> factors;
-
-    T2 divisor = pollardRhO(value);
-    if (isPrime(modNum<T2>(value, value + 1), 10))
-        factors.push_back(divisor);
-    else
+    if constexpr (std::is_same<T1, mpz_class>::value)
     {
-        vector<T2> tmp = factor(divisor);
-        factors.insert(factors.end(), tmp.begin(), tmp.end());
+        if (!mpz_perfect_square_p(value.get_mpz_t()))
+            return false;
+        mpz_sqrt(root.get_mpz_t(), value.get_mpz_t());
+        return true;
+    }
+    else if constexpr (std::is_integral<T1>::value)
+    {
+        root = static_cast<T1>(integerSqrt(static_cast<uint64_t>(value)));
+        return root * root == value;
     }
-
-    value = value / divisor;
-
-    if (isPrime(modNum<T2>(value, value + 1), 10))
-        factors.push_back(value);
     else
     {
-        vector<T2> tmp = factor(value);
-        factors.insert(factors.end(), tmp.begin(), tmp.end());
+        return false;
     }
+}
 
-    return factors;
+/**
+ *  @brief Factorization using Pollard's rho algorithm
+ *  @param value number
+ *  @return vector of factors
+ */
+template <typename T1>
+template <typename T2>
+std::vector<T2>
+modNum<T1>::Pollard<T2>::factor(T2 value)
+{
+    // rho is the fallback of the driver, there is no other search to run
+    return smoothFactor(value, [](const mpz_class &) { return mpz_class(1); });
 }
 
 /**
@@ -130,27 +313,10 @@ modNum<T1>::Naive<T2>::factor(T2 m)
         throw invalid_argument(" value is less than 1");
     else if (m == 1)
         return vector<T2>{};
-    else if (isPrimeSimple(m))
-        return vector<T2>{m};
 
     vector<T2> factors;
-
-    T2 p = 2;
-    while (p * p <= m)
-    {
-        if (m % p == 0)
-        {
-            m = m / p;
-            factors.push_back(p);
-        }
-        else
-        {
-            p++;
-        }
-    }
-
-    if (m > 1)
-        factors.push_back(m);
+    forEachPrimeFactor(m, [&factors](const T2 &p, unsigned exponent)
+                       { factors.insert(factors.end(), exponent, p); });
 
     return factors;
 }
@@ -167,7 +333,9 @@ class Adapter : public modNum<T1>
         this->setStrat(strat);
 
         std::vector<T1> factors = this->factorize();
-    
+        // strategies return factors in discovery order, callers expect them ascending
+        std::sort(factors.begin(), factors.end());
+
         std::vector<modNum<T1>> res;
         T1 mod = this->getMod();
         for (int i = 0; i < factors.size(); i++)
@@ -181,7 +349,7 @@ class Adapter : public modNum<T1>
 template <typename T1>
 std::vector<modNum<T1>>
 modular::factorize(modNum<T1> value) {
-    typename modNum<T1>::template Naive<T1> strat;
+    typename modNum<T1>::template Pollard<T1> strat;
     
     Adapter<T1> adapter(value.getValue(), value.getMod());
     std::vector<modNum<T1>> res = adapter.factorizeMod(&strat);
@@ -0,0 +1,95 @@
+#include "../mod-math.h"
+#include "fpow.tcc"
+
+namespace modular
+{
+#ifndef FIXED_BASE_POW
+#define FIXED_BASE_POW
+
+    /**
+     *  @brief Precomputes the comb table
+     *  @param _base base
+     *  @param maxBits longest exponent answered from the table, 0 for the bit length of the modulus
+     *  @param _teeth number of comb teeth
+     *
+     *  Entry m of the table is the product of base^(2^(j * spacing)) over the bits j of m,
+     *  every entry costs one multiplication once the rows are known.
+     *
+     *  @throws invalid_argument if the number of teeth is not in range [1, 16]
+     */
+    template <typename T>
+    fixedBasePow<T>::fixedBasePow(const modNum<T> &_base, size_t maxBits, size_t _teeth)
+        : ring(_base.getMod()), base(_base.getValue()), teeth(_teeth)
+    {
+        if (teeth < 1 || teeth > 16)
+        {
+            throw std::invalid_argument("number of comb teeth should be in range [1, 16]");
+        }
+        if (maxBits == 0)
+            maxBits = std::max<size_t>(exponentBitLength(ring.getMod()), 1);
+        spacing = (maxBits + teeth - 1) / teeth;
+
+        table.assign(static_cast<size_t>(1) << teeth, ring.element(1));
+        T row = base;
+        for (size_t j = 0; j < teeth; ++j)
+        {
+            size_t bit = static_cast<size_t>(1) << j;
+            table[bit] = row;
+            for (size_t m = 1; m < bit; ++m)
+                table[bit | m] = ring.mult(table[m], row);
+            if (j + 1 < teeth)
+            {
+                for (size_t i = 0; i < spacing; ++i)
+                    ring.multAssign(row, row);
+            }
+        }
+    }
+
+    /**
+     *  @brief Raises the base to a power with the comb table
+     *  @param power non-negative exponent
+     *
+     *  Column i of the comb collects the bits i, i + spacing, i + 2 * spacing, ...
+     *  of the exponent into a table index; columns are processed from the top,
+     *  with one squaring between them.
+     *
+     *  @return base^power
+     */
+    template <typename T>
+    modNum<T> fixedBasePow<T>::pow(const T &power) const
+    {
+        if (base == 0 && power == 0)
+        {
+            throw std::invalid_argument("0 pow 0 is undefined");
+        }
+        size_t bits = exponentBitLength(power);
+        if (bits > getMaxBits())
+        {
+            return fpow(ring.toModNum(base), power);
+        }
+
+        T result = ring.element(1);
+        bool started = false;
+        for (size_t i = spacing; i > 0; --i)
+        {
+            if (started)
+                ring.multAssign(result, result);
+
+            size_t index = 0;
+            for (size_t j = 0; j < teeth; ++j)
+            {
+                size_t position = j * spacing + i - 1;
+                if (position < bits && exponentBit(power, position))
+                    index |= static_cast<size_t>(1) << j;
+            }
+            if (index != 0)
+            {
+                ring.multAssign(result, table[index]);
+                started = true;
+            }
+        }
+        return ring.toModNum(result);
+    }
+
+#endif
+} // namespace modular
@@ -0,0 +1,150 @@
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef FIXED_MOD_NUM
+#define FIXED_MOD_NUM
+
+    template <typename T, T MOD>
+    constexpr size_t fixedModNum<T, MOD>::modBits()
+    {
+        size_t bits = 0;
+        for (uint64_t tmp = static_cast<uint64_t>(MOD); tmp > 0; tmp >>= 1)
+            bits++;
+        return bits;
+    }
+
+    template <typename T, T MOD>
+    constexpr bool fixedModNum<T, MOD>::isPseudoMersenne()
+    {
+        uint64_t c = (static_cast<uint64_t>(1) << modBits()) - static_cast<uint64_t>(MOD);
+        return c < (static_cast<uint64_t>(1) << (modBits() / 2));
+    }
+
+    /**
+     *  @brief Reduces a product of two residues
+     *  @param x value below MOD^2
+     *
+     *  The branch is chosen at compile time, none of them divides at runtime:
+     *  2^k - c folds x = hi * 2^k + lo into lo + c * hi twice,
+     *  small moduli use a division by a constant (a multiplication after compilation),
+     *  the rest use a Barrett constant computed by the compiler.
+     *
+     *  @return x mod MOD
+     */
+    template <typename T, T MOD>
+    constexpr uint64_t fixedModNum<T, MOD>::reduce(unsigned __int128 x)
+    {
+        constexpr uint64_t mod = static_cast<uint64_t>(MOD);
+        if constexpr (isPseudoMersenne())
+        {
+            constexpr size_t k = modBits();
+            constexpr uint64_t c = (static_cast<uint64_t>(1) << k) - mod;
+            constexpr unsigned __int128 mask = (static_cast<unsigned __int128>(1) << k) - 1;
+            x = (x & mask) + c * (x >> k);
+            x = (x & mask) + c * (x >> k);
+            while (x >= mod)
+                x -= mod;
+            return static_cast<uint64_t>(x);
+        }
+        else if constexpr (mod < (static_cast<uint64_t>(1) << 32))
+        {
+            return static_cast<uint64_t>(x) % mod;
+        }
+        else
+        {
+            constexpr BarrettReducer reducer(mod);
+            return reducer.reduce(x);
+        }
+    }
+
+    template <typename T, T MOD>
+    constexpr fixedModNum<T, MOD>::fixedModNum(T _value) : value(_value % MOD)
+    {
+        if (value < 0)
+            value += MOD;
+    }
+
+    template <typename T, T MOD>
+    fixedModNum<T, MOD>
+    fixedModNum<T, MOD>::inv() const
+    {
+        fixedModNum result;
+        result.value = modInverse(value, MOD);
+        return result;
+    }
+
+    template <typename T, T MOD>
+    constexpr fixedModNum<T, MOD>
+    fixedModNum<T, MOD>::operator+(const fixedModNum &other) const
+    {
+        // both values are below 2^63, the sum fits into 64 bits
+        uint64_t sum = static_cast<uint64_t>(value) + static_cast<uint64_t>(other.value);
+        if (sum >= static_cast<uint64_t>(MOD))
+            sum -= static_cast<uint64_t>(MOD);
+        fixedModNum result;
+        result.value = static_cast<T>(sum);
+        return result;
+    }
+
+    template <typename T, T MOD>
+    constexpr fixedModNum<T, MOD>
+    fixedModNum<T, MOD>::operator-(const fixedModNum &other) const
+    {
+        fixedModNum result;
+        result.value = value >= other.value ? value - other.value : value + (MOD - other.value);
+        return result;
+    }
+
+    template <typename T, T MOD>
+    constexpr fixedModNum<T, MOD>
+    fixedModNum<T, MOD>::operator*(const fixedModNum &other) const
+    {
+        fixedModNum result;
+        result.value = static_cast<T>(
+            reduce(static_cast<unsigned __int128>(value) * static_cast<uint64_t>(other.value)));
+        return result;
+    }
+
+    template <typename T, T MOD>
+    fixedModNum<T, MOD>
+    fpow(fixedModNum<T, MOD> value, T power)
+    {
+        if (value == fixedModNum<T, MOD>(0) && power == 0)
+        {
+            throw std::invalid_argument("0 pow 0 is undefined");
+        }
+
+        fixedModNum<T, MOD> res(1);
+        while (power > 0)
+        {
+            if (power & 1)
+                res = res * value;
+            value = value * value;
+            power >>= 1;
+        }
+        return res;
+    }
+
+    template <typename T, T MOD>
+    bool
+    isGenerator(fixedModNum<T, MOD> value)
+    {
+        return isGenerator(value.toModNum());
+    }
+
+    template <typename T, T MOD>
+    std::vector<T>
+    sqrt(fixedModNum<T, MOD> value)
+    {
+        return sqrt(value.toModNum());
+    }
+
+    template <typename T, T MOD>
+    T log(fixedModNum<T, MOD> value, fixedModNum<T, MOD> base)
+    {
+        return log(value.toModNum(), base.toModNum());
+    }
+
+#endif
+} // namespace modular
@@ -1,180 +1,261 @@
+#include <iostream>
+
+#include "../mod-math.h"
+
 namespace modular
 {
 
 #ifndef ALGEBRA_INVERSION_AND_DIVISION
 #define ALGEBRA_INVERSION_AND_DIVISION
-#include <iostream>
-
-#include "../mod-math.h"
 
     using namespace std;
 
     /**
     @file fpow.tcc
-    @brief Implementation of Montgomery modular exponentiation algorithm
+    @brief Implementation of modular exponentiation engines
     */
-    /**
 
-    @brief Calculates the length of a number in a given base
-    @tparam T1 Type of input number and base
-    @param n Input number
-    @param b Base
-    @return Length of the number
-    */
-    template <typename T1>
-    T1
-    number_length(T1 n, T1 b)
+    template <typename T>
+    T logPow(T base, T power, T MOD)
     {
-        int len = 0;
-        while (n > 0)
+        T result = 1;
+        while (power > 0)
         {
-            n /= b;
-            len++;
+            if (power % 2 == 1)
+            { // Can also use (power & 1) to make code even faster
+                result = (result * base) % MOD;
+            }
+            base = (base * base) % MOD;
+            power = power / 2; // Can also use power >>= 1; to make code even faster
         }
-        return len;
+        return result;
     }
-    /**
 
-    @brief Calculates k such that b^k > n
-    @tparam T1 Type of input number and base
-    @param n Input number
-    @param b Base
-    @return Value of k
-    */
+    /**
+     *  @brief Number of significant bits of a non-negative exponent
+     *  @param power exponent
+     *  @return bit length, 0 for non-positive exponents
+     */
     template <typename T1>
-    T1
-    get_k(T1 n, T1 b)
+    size_t exponentBitLength(const T1 &power)
     {
-        T1 k = 0;
-        while (b > 1 && b <= n)
-        {
-            b *= b;
-            k++;
-        }
-        return k;
+        if (power <= 0)
+            return 0;
+        if constexpr (std::is_same<T1, mpz_class>::value)
+            return mpz_sizeinbase(power.get_mpz_t(), 2);
+        size_t bits = 0;
+        for (T1 rest = power; rest > 0; rest /= 2)
+            bits++;
+        return bits;
     }
-    /**
 
-    @brief Computes the resulting multiplier for Montgomery algorithm
-    @tparam T1 Type of input number and base
-    @param n Input number
-    @return Value of t
-    */
+    /**
+     *  @brief Bit of a non-negative exponent
+     *  @param power exponent
+     *  @param index bit position
+     *  @return true if the bit is set
+     */
     template <typename T1>
-    T1
-    get_t(T1 n)
+    bool exponentBit(const T1 &power, size_t index)
     {
-        T1 t = 1;
-        T1 two = 2;
-        T1 k = number_length(n, two);
-        for (int i = 0; i < k; i++)
+        if constexpr (std::is_same<T1, mpz_class>::value)
+            return mpz_tstbit(power.get_mpz_t(), index);
+        else if constexpr (std::is_integral<T1>::value)
+            return (power >> index) & 1;
+        else
         {
-            t = (t * t) % n;
+            T1 rest = power;
+            for (size_t i = 0; i < index; ++i)
+                rest /= 2;
+            return rest % 2 == 1;
         }
-        return t;
     }
+
     /**
+     *  @brief Window size for sliding-window exponentiation
+     *  @param bits bit length of the exponent
+     *  @return k, the odd-power table holds 2^(k-1) entries
+     *
+     *  Thresholds minimise bits + bits / (k + 1) + 2^(k-1), the number of
+     *  squarings, window multiplications and table entries.
+     */
+    inline size_t slidingWindowSize(size_t bits)
+    {
+        if (bits <= 8)
+            return 1;
+        if (bits <= 24)
+            return 2;
+        if (bits <= 80)
+            return 3;
+        if (bits <= 240)
+            return 4;
+        if (bits <= 672)
+            return 5;
+        if (bits <= 1792)
+            return 6;
+        return 7;
+    }
 
-    @brief Computes the modular exponentiation of a number using Montgomery algorithm
+    /**
+     *  @brief Sliding-window recoding of an exponent
+     *  @param power non-negative exponent
+     *  @param window window size
+     *
+     *  Every window starts and ends with a one bit, its odd value is stored at the
+     *  position of its lowest bit, all other positions hold 0.
+     *
+     *  @return odd digits indexed by bit position
+     */
+    template <typename T>
+    std::vector<size_t> slidingWindowDigits(const T &power, size_t window)
+    {
+        size_t bits = exponentBitLength(power);
+        std::vector<size_t> digits(bits, 0);
+        size_t i = bits;
+        while (i > 0)
+        {
+            size_t top = i - 1;
+            if (!exponentBit(power, top))
+            {
+                i = top;
+                continue;
+            }
+            size_t low = top + 1 >= window ? top + 1 - window : 0;
+            while (!exponentBit(power, low))
+                low++;
 
-    @tparam T1 Type of input number and base
+            size_t digit = 0;
+            for (size_t j = top + 1; j > low; --j)
+                digit = digit * 2 + exponentBit(power, j - 1);
+            digits[low] = digit;
+            i = low;
+        }
+        return digits;
+    }
 
-    @param value Base
+    /**
+     *  @brief Left-to-right sliding-window exponentiation
+     *  @param base base, in the representation used by multAssign
+     *  @param power non-negative exponent
+     *  @param one neutral element in the same representation
+     *  @param multAssign function (T &a, const T &b) computing a = a * b
+     *
+     *  Precomputes base^1, base^3, ..., base^(2^k - 1) once per call, then every
+     *  window of up to k bits starting and ending with a one costs a single
+     *  multiplication on top of the squarings.
+     *
+     *  @return base^power
+     */
+    template <typename T, typename T1, typename Mult>
+    T slidingWindowPow(const T &base, const T1 &power, const T &one, const Mult &multAssign)
+    {
+        size_t bits = exponentBitLength(power);
+        if (bits == 0)
+            return one;
 
-    @param power Exponent
+        size_t window = slidingWindowSize(bits);
+        std::vector<T> oddPowers(static_cast<size_t>(1) << (window - 1), base);
+        if (window > 1)
+        {
+            T square = base;
+            multAssign(square, base);
+            for (size_t i = 1; i < oddPowers.size(); ++i)
+            {
+                oddPowers[i] = oddPowers[i - 1];
+                multAssign(oddPowers[i], square);
+            }
+        }
 
-    @param n Modulus(get from class modNum)
+        std::vector<size_t> digits = slidingWindowDigits(power, window);
+        T result = one;
+        bool started = false;
+        for (size_t i = bits; i > 0; --i)
+        {
+            if (started)
+                multAssign(result, result);
+            size_t digit = digits[i - 1];
+            if (digit == 0)
+                continue;
+            if (started)
+            {
+                multAssign(result, oddPowers[digit / 2]);
+            }
+            else
+            {
+                result = oddPowers[digit / 2];
+                started = true;
+            }
+        }
+        return result;
+    }
 
-    @return The result of a^b mod n
-    */
     template <typename T1>
     modNum<T1>
-    fpowdiif(modNum<T1> value, T1 power)
+    classicLogPow(modNum<T1> value, T1 power)
     {
-        if (value == static_cast<T1>(0) && power == 0)
+        if constexpr (std::is_integral<T1>::value && sizeof(T1) <= 8)
         {
-            throw std::invalid_argument("0 pow 0 is undefined");
+            // word-size moduli: reduce 128-bit products with a precomputed Barrett constant
+            BarrettReducer reducer(static_cast<uint64_t>(value.getMod()));
+            uint64_t result = slidingWindowPow(static_cast<uint64_t>(value.getValue()), power, reducer.reduce(1),
+                                               [&reducer](uint64_t &a, const uint64_t &b)
+                                               { a = reducer.mult(a, b); });
+            return modNum<T1>(static_cast<T1>(result), value.getMod());
+        }
+        else
+        {
+            return slidingWindowPow(value, power, modNum<T1>(1, value.getMod()),
+                                    [](modNum<T1> &a, const modNum<T1> &b) { a *= b; });
         }
+    }
 
-        T1 n = value.getMod();
-        T1 two = 2;
-        T1 k = get_k(n, two);
-        T1 r = 1;
-        T1 t = get_t(n);
+    /**
 
-        return modNum<T1>((r * t) % n, value.getMod());
-    }
+    @brief Computes the modular exponentiation of a number in Montgomery form
 
-    template <typename T>
-    modNum<T>
-    REDC(T num, T r, T MOD)
-    {
-        T n = modNum<T>(MOD, r).inv().getValue();
-        T m = ((num % r) * n) % r;
-        T res = (num - m * MOD) / r;
-        res = (res < 0) ? res + MOD : res;
-        return modNum<T>(res, MOD);
-    }
+    The constants of the modulus are computed once, the base is converted once and
+    the whole sliding-window ladder runs on Montgomery products, so each step
+    costs one REDC instead of a division. Long arithmetic goes to mpz_powm, other
+    moduli that a context does not support (even ones, or ones without a spare bit
+    in a built-in type) use classicLogPow.
 
-    template <typename T>
-    T logPow(T base, T power, T MOD)
-    {
-        T result = 1;
-        while (power > 0)
-        {
-            if (power % 2 == 1)
-            { // Can also use (power & 1) to make code even faster
-                result = (result * base) % MOD;
-            }
-            base = (base * base) % MOD;
-            power = power / 2; // Can also use power >>= 1; to make code even faster
-        }
-        return result;
-    }
+    @tparam T Type of input number and base
+
+    @param value Base
+
+    @param power Exponent
 
+    @return The result of value^power mod n
+    */
     template <typename T>
     modNum<T>
-    fpowMontogomery(modNum<T> value, T power)
+    fpowMontgomery(modNum<T> value, T power)
     {
-        if (value == static_cast<T>(0) && power == 0)
+        if (value.getValue() == 0 && power == 0)
         {
             throw std::invalid_argument("0 pow 0 is undefined");
         }
-        T MOD = value.getMod();
-        T r = 4096;
-        while (r <= MOD)
-            r = 2 * r;
-
-        value = REDC(static_cast<T>(value.getValue() * ((r * r) % MOD)), r, MOD);
-        modNum<T> result = modNum<T>(1, MOD);
-
-        while (power > 0)
+        if constexpr (std::is_same<T, mpz_class>::value)
         {
-            if (power % 2 == 1)
-            { // Can also use (power & 1) to make code even faster
-                result = result * value;
+            // GMP runs its own windowed REDC ladder on raw limbs (and a CRT split for even
+            // moduli), which the mpz_class interface of MontgomeryContext can not match
+            if (power >= 0)
+            {
+                mpz_class result;
+                mpz_powm(result.get_mpz_t(), value.getValue().get_mpz_t(), power.get_mpz_t(),
+                         value.getMod().get_mpz_t());
+                return modNum<T>(std::move(result), value.getMod(), reducedTag());
             }
-            value = value * value;
-            power = power / 2; // Can also use power >>= 1; to make code even faster
         }
-        return REDC(static_cast<T>(result.getValue() * r % MOD), r, MOD);
-    }
-
-    template <typename T1>
-    modNum<T1>
-    classicLogPow(modNum<T1> value, T1 power)
-    {
-        modNum<T1> res = modNum<T1>(1, value.getMod());
-        T1 two = 2;
-        T1 one = 1;
-        while (power)
+        if (!MontgomeryContext<T>::supports(value.getMod()))
         {
-            if (power % two == one)
-                res = res * value;
-            value = value * value;
-            power /= two;
+            return classicLogPow(value, power);
         }
-        return res;
+
+        MontgomeryContext<T> ctx(value.getMod());
+        T result = slidingWindowPow(ctx.fromModNum(value), power, ctx.one(),
+                                    [&ctx](T &a, const T &b) { a = ctx.mult(a, b); });
+        return ctx.toModNum(result);
     }
 
     template <typename T1>
@@ -195,15 +276,32 @@ namespace modular
         return res;
     }
 
+    /**
+     *  @brief Picks the engine for powEngine::automatic
+     *  @param MOD modulus
+     *  @return montgomery for long arithmetic and for moduli a context supports, classic otherwise
+     */
+    template <typename T1>
+    powEngine choosePowEngine(const T1 &MOD)
+    {
+        if (std::is_same<T1, mpz_class>::value || MontgomeryContext<T1>::supports(MOD))
+            return powEngine::montgomery;
+        return powEngine::classic;
+    }
+
     template <typename T1>
     modNum<T1>
-    fpow(modNum<T1> value, T1 power)
+    fpow(modNum<T1> value, T1 power, powEngine engine)
     {
-        if (value == static_cast<T1>(0) && power == static_cast<T1>(0))
+        if (value.getValue() == 0 && power == 0)
         {
             throw std::invalid_argument("0 pow 0 is undefined");
         }
 
+        if (engine == powEngine::automatic)
+            engine = choosePowEngine(value.getMod());
+        if (engine == powEngine::montgomery)
+            return fpowMontgomery(value, power);
         return classicLogPow(value, power);
     }
 #endif
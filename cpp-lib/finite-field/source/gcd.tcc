@@ -0,0 +1,114 @@
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef EXTENDED_GCD
+#define EXTENDED_GCD
+
+    /**
+     *  @brief Extended Euclidean algorithm without recursion
+     *  @param a first number
+     *  @param b second number
+     *  @param x coefficient of a
+     *  @param y coefficient of b
+     *  @return gcd of a and b
+     */
+    template <typename T>
+    T extendedGcd(const T &a, const T &b, T &x, T &y)
+    {
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            T g;
+            mpz_gcdext(g.get_mpz_t(), x.get_mpz_t(), y.get_mpz_t(), a.get_mpz_t(), b.get_mpz_t());
+            return g;
+        }
+        else
+        {
+            T oldR = a, r = b;
+            T oldX = 1, curX = 0;
+            T oldY = 0, curY = 1;
+            while (r != 0)
+            {
+                T q = oldR / r;
+
+                T tmp = oldR - q * r;
+                oldR = r;
+                r = tmp;
+
+                tmp = oldX - q * curX;
+                oldX = curX;
+                curX = tmp;
+
+                tmp = oldY - q * curY;
+                oldY = curY;
+                curY = tmp;
+            }
+            x = oldX;
+            y = oldY;
+            return oldR;
+        }
+    }
+
+    /**
+     *  @brief Inverses the given element in a modular field
+     *  @param value element to be inversed
+     *  @param mod module
+     *
+     *  Only the coefficient of value is tracked, so built-in types need
+     *  one division and two multiplications per step and no recursion.
+     *
+     *  @return inversed element
+     */
+    template <typename T>
+    T modInverse(const T &value, const T &mod)
+    {
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            T result;
+            if (mpz_invert(result.get_mpz_t(), value.get_mpz_t(), mod.get_mpz_t()) == 0)
+            {
+                throw std::invalid_argument("Inverse does not exist here.");
+            }
+            return result;
+        }
+        else if constexpr (std::is_integral<T>::value)
+        {
+            __int128 r0 = static_cast<__int128>(mod), r1 = static_cast<__int128>(value);
+            __int128 s0 = 0, s1 = 1;
+            while (r1 != 0)
+            {
+                __int128 q = r0 / r1;
+
+                __int128 tmp = r0 - q * r1;
+                r0 = r1;
+                r1 = tmp;
+
+                tmp = s0 - q * s1;
+                s0 = s1;
+                s1 = tmp;
+            }
+            if (r0 != 1)
+            {
+                throw std::invalid_argument("Inverse does not exist here.");
+            }
+            s0 %= static_cast<__int128>(mod);
+            if (s0 < 0)
+                s0 += static_cast<__int128>(mod);
+            return static_cast<T>(s0);
+        }
+        else
+        {
+            T x, y;
+            if (extendedGcd(value, mod, x, y) != 1)
+            {
+                throw std::invalid_argument("Inverse does not exist here.");
+            }
+            x %= mod;
+            if (x < 0)
+                x += mod;
+            return x;
+        }
+    }
+
+#endif
+} // namespace modular
@@ -2,7 +2,7 @@
 #include <numeric>
 #include <utility>
 
-#include "factorization.tcc"
+#include "factor-cache.tcc"
 #include "mod-num.tcc"
 
 namespace modular
@@ -23,19 +23,23 @@ namespace modular
         T t = a.getMod();
         modNum<T> b, one(static_cast<T>(1), a.getMod());
 
-        vector<modNum<T>> factors = factorize(modNum<T>(t - 1, t + 1));
-
-        std::map<modNum<T>, size_t> factorsCombined;
+        std::map<T, unsigned> factorsCombined = cachedFactorization(static_cast<T>(t - 1));
+        T n = a.getMod(), pi;
 
-        for (auto factor : factors)
+        if (std::is_integral<T>::value && factorsCombined.size() > 1)
         {
-            factorsCombined[factor]++;
+            // one comb table answers every power of a, the exponents n / pi fit its width
+            fixedBasePow<T> powers(a, 0, 4);
+            for (auto num : factorsCombined)
+            {
+                if (powers.pow(static_cast<T>(n / num.first)) == one)
+                    return false;
+            }
+            return true;
         }
-        T n = a.getMod(), pi;
-
         for (auto num : factorsCombined)
         {
-            pi = num.first.getValue();
+            pi = num.first;
             b = fpow(a, static_cast<T>(n / pi));
             if (b == one)
                 return false;
@@ -1,67 +1,225 @@
-#include <random>
+#include <cstdint>
 
 #include "../mod-math.h"
+#include "small-primes.tcc"
 namespace modular {
 #ifndef TASK_10
 #define TASK_10
 
 /**
- *  @brief Probabilistic check of a number for simplicity (Miller-Rabin test)
- *  @param  base value
- *  @param  k  the number of iteration of of the algorithm
+ *  @brief Strong probable prime test of an odd word to one base
+ *  @param  reducer Barrett reducer of the tested number n
+ *  @param  base witness
+ *  @param  d odd part of n - 1
+ *  @param  s power of two in n - 1
+ *
+ *  @return returns TRUE if n is a strong probable prime to the base
+ */
+inline bool strongProbablePrimeWord(const BarrettReducer &reducer, uint64_t base, uint64_t d, unsigned s) {
+    uint64_t n = reducer.getMod();
+    base %= n;
+    if (base == 0)
+        return true;
+
+    uint64_t x = reducer.reduce(1);
+    for (uint64_t power = d; power > 0; power >>= 1) {
+        if (power & 1)
+            x = reducer.mult(x, base);
+        base = reducer.mult(base, base);
+    }
+    if (x == 1 || x == n - 1)
+        return true;
+    for (unsigned r = 1; r < s; ++r) {
+        x = reducer.mult(x, x);
+        if (x == n - 1)
+            return true;
+    }
+    return false;
+}
+
+/**
+ *  @brief Deterministic Miller-Rabin test for 64-bit numbers
+ *  @param  n value
  *
+ *  The witnesses 2, 325, 9375, 28178, 450775, 9780504, 1795265022 (Jim Sinclair)
+ *  have no common strong pseudoprime below 2^64.
  *
- *  @return returns TRUE if value is probably prime, FALSE if value is compound
+ *  @return returns TRUE if n is prime
  */
+inline bool isPrimeWord(uint64_t n) {
+    sieveVerdict verdict = smallPrimeFilterWord(n);
+    if (verdict != sieveVerdict::unknown)
+        return verdict == sieveVerdict::prime;
 
-template <typename T1>
-bool
-isPrime(modNum<T1> base, size_t k) {
-    T1 value = base.getValue();
+    uint64_t d = n - 1;
+    unsigned s = 0;
+    while (d % 2 == 0) {
+        d /= 2;
+        s++;
+    }
 
-    // Edge case
-    if (value == 3 || value == 2)
-        return true;
-    if (value <= 1 || value == 4 || value % 2 == 0)
-        return false;
+    BarrettReducer reducer(n);
+    static constexpr uint64_t witnesses[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    for (uint64_t base : witnesses) {
+        if (!strongProbablePrimeWord(reducer, base, d, s))
+            return false;
+    }
+    return true;
+}
 
-    // Set k to a default value of 1 if it is less than 1
-    if (k < 1)
-        k = 1;
+/**
+ *  @brief Halves a residue modulo an odd n
+ *  @param  x residue in range [0, n), replaced by x / 2 mod n
+ *  @param  n odd modulus
+ */
+inline void halveMod(mpz_class &x, const mpz_class &n) {
+    if (mpz_odd_p(x.get_mpz_t()))
+        x += n;
+    x >>= 1;
+}
 
-    T1 up = value - 1;
-    T1 s = 0;
+/**
+ *  @brief Strong Lucas probable prime test with Selfridge parameters
+ *  @param  n odd number, not a perfect square
+ *
+ *  D is the first of 5, -7, 9, -11, ... with Jacobi symbol (D/n) = -1, P = 1 and
+ *  Q = (1 - D) / 4. With n + 1 = d * 2^s, n passes if U_d = 0 or V_(d*2^r) = 0
+ *  for some 0 <= r < s.
+ *
+ *  @return returns TRUE if n is a strong Lucas probable prime
+ */
+inline bool strongLucasProbablePrime(const mpz_class &n) {
+    long D = 5;
+    while (true) {
+        int jacobi = mpz_si_kronecker(D, n.get_mpz_t());
+        if (jacobi == -1)
+            break;
+        if (jacobi == 0 && mpz_cmpabs_ui(n.get_mpz_t(), static_cast<unsigned long>(D < 0 ? -D : D)) != 0)
+            return false;
+        D = D > 0 ? -(D + 2) : -D + 2;
+    }
+    mpz_class P = 1, Q = (1 - D) / 4, DD = D;
 
-    while (up % 2 == 0) {
-        up /= 2;
-        s++;
+    mpz_class d = n + 1;
+    unsigned long s = mpz_scan1(d.get_mpz_t(), 0);
+    d >>= s;
+
+    // U_1 = 1, V_1 = P, Q^1 = Q, then left-to-right over the remaining bits of d
+    mpz_class U = 1, V = P, Qk = Q, tmp;
+    mpz_mod(Qk.get_mpz_t(), Qk.get_mpz_t(), n.get_mpz_t());
+    for (size_t bit = mpz_sizeinbase(d.get_mpz_t(), 2) - 1; bit > 0; --bit) {
+        // U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+        U = U * V % n;
+        V = V * V - 2 * Qk;
+        mpz_mod(V.get_mpz_t(), V.get_mpz_t(), n.get_mpz_t());
+        Qk = Qk * Qk % n;
+        if (mpz_tstbit(d.get_mpz_t(), bit - 1)) {
+            // U_k+1 = (P U_k + V_k) / 2, V_k+1 = (D U_k + P V_k) / 2
+            tmp = P * U + V;
+            V = DD * U + P * V;
+            mpz_mod(tmp.get_mpz_t(), tmp.get_mpz_t(), n.get_mpz_t());
+            mpz_mod(V.get_mpz_t(), V.get_mpz_t(), n.get_mpz_t());
+            U = tmp;
+            halveMod(U, n);
+            halveMod(V, n);
+            Qk = Qk * Q % n;
+            mpz_mod(Qk.get_mpz_t(), Qk.get_mpz_t(), n.get_mpz_t());
+        }
     }
 
-    // Repeat the test k times
-    for (size_t i = 0; i < k; i++) {
-        // Choose a random integer a between 2 and value-2
-        T1 rand_number = rand() % (value - 4) + 2;
+    if (U == 0 || V == 0)
+        return true;
+    for (unsigned long r = 1; r < s; ++r) {
+        V = V * V - 2 * Qk;
+        mpz_mod(V.get_mpz_t(), V.get_mpz_t(), n.get_mpz_t());
+        if (V == 0)
+            return true;
+        Qk = Qk * Qk % n;
+    }
+    return false;
+}
 
-        // Compute y = rand_number^up mod value
-        T1 y = fpow(modNum<T1>(rand_number, value), up).getValue();
+/**
+ *  @brief Baillie-PSW test: strong base-2 Miller-Rabin and strong Lucas test
+ *  @param  n value
+ *
+ *  Numbers below 2^64 are decided by the deterministic word test, no BPSW
+ *  pseudoprime is known above.
+ *
+ *  @return returns TRUE if n is (probably, above 2^64) prime
+ */
+inline bool isPrimeBPSW(const mpz_class &n) {
+    if (n < 2)
+        return false;
+    if (mpz_sizeinbase(n.get_mpz_t(), 2) <= 64)
+        return isPrimeWord(static_cast<uint64_t>(mpz_getlimbn(n.get_mpz_t(), 0)));
 
-        if (y != 1 && y != value - 1) {
-            for (T1 j = 0; j < s && y != value - 1; j++) {
-                y = (fpow(modNum<T1>(y, value), static_cast<T1>(2)).getValue());
+    if (smallPrimeFilter(n) == sieveVerdict::composite)
+        return false;
 
-                // If y == 1, value is composite
-                if (y == 1)
-                    return false;
-            }
+    mpz_class d = n - 1, x;
+    unsigned long s = mpz_scan1(d.get_mpz_t(), 0);
+    d >>= s;
+    mpz_class nMinusOne = n - 1, two = 2;
+    mpz_powm(x.get_mpz_t(), two.get_mpz_t(), d.get_mpz_t(), n.get_mpz_t());
+    if (x != 1 && x != nMinusOne) {
+        unsigned long r = 1;
+        for (; r < s && x != nMinusOne; ++r)
+            x = x * x % n;
+        if (x != nMinusOne)
+            return false;
+    }
 
-            // If y != value-1, value is composite
-            if (y != value - 1)
-                return false;
+    if (mpz_perfect_square_p(n.get_mpz_t()))
+        return false;
+    return strongLucasProbablePrime(n);
+}
+
+/**
+ *  @brief Deterministic primality test of a plain value
+ *  @param  value value
+ *
+ *  Words go to Miller-Rabin with the 7-witness set, larger values to Baillie-PSW.
+ *
+ *  @return returns TRUE if value is prime
+ */
+template <typename T1>
+bool isPrimeValue(const T1 &value) {
+    if constexpr (std::is_same<T1, mpz_class>::value) {
+        return isPrimeBPSW(value);
+    } else {
+        if (value < 2)
+            return false;
+        if constexpr (sizeof(T1) <= sizeof(uint64_t)) {
+            return isPrimeWord(static_cast<uint64_t>(value));
+        } else {
+            uint64_t high = static_cast<uint64_t>(value >> 64), low = static_cast<uint64_t>(value);
+            if (high == 0)
+                return isPrimeWord(low);
+            mpz_class wide = static_cast<unsigned long>(high);
+            wide = (wide << 64) + static_cast<unsigned long>(low);
+            return isPrimeBPSW(wide);
         }
     }
+}
 
-    // If the test has not found a composite value, value is probably prime
-    return true;
+/**
+ *  @brief Deterministic check of a number for simplicity
+ *  @param  base value
+ *  @param  k  ignored, kept for compatibility with the randomized test
+ *
+ *  Built-in types and values below 2^64 use Miller-Rabin with a fixed 7-witness set,
+ *  which has no false positives in that range. Larger values use Baillie-PSW.
+ *  The cost does not depend on k.
+ *
+ *  @return returns TRUE if value is prime, FALSE if value is compound
+ */
+
+template <typename T1>
+bool
+isPrime(modNum<T1> base, size_t k) {
+    (void)k;
+    return isPrimeValue(base.getValue());
 }
 #endif
-}   // namespace modular
\ No newline at end of file
+}   // namespace modular
@@ -11,23 +11,6 @@ namespace modular
 {
 #ifndef LOG_H
 #define LOG_H
-    /**
-     *
-     * @brief Custom hash function for the modNum type.
-     * This struct provides a custom hash function implementation for objects of type modNum.
-     * @tparam numT The type of values stored in modNum.
-     */
-
-    template <class numT>
-    struct customHash
-    {
-    private:
-        std::hash<numT> hasher;
-
-    public:
-        size_t operator()(const modNum<numT> &number) const { return hasher(number.getValue()); }
-    };
-
     /*
      * @brief Computes the discrete logarithm of a value in a group.
      * @tparam numT The type of values stored in modNum.
@@ -45,30 +28,38 @@ namespace modular
         if (!isGenerator(base))
             throw std::invalid_argument("Base of a logarithm must be a group Generator");
 
-        numT m = static_cast<numT>(std::sqrt(base.getMod().get_d()));
+        numT m;
+        if constexpr (std::is_integral<numT>::value)
+            m = static_cast<numT>(std::sqrt(static_cast<double>(base.getMod())));
+        else
+            m = static_cast<numT>(std::sqrt(base.getMod().get_d()));
         while (m * m < base.getMod())
             m++;
 
-        std::unordered_map<modNum<numT>, numT, customHash<numT>> table;
+        // the table keeps bare residues, the modulus lives in the ring only
+        modRing<numT> ring(base.getMod());
+        std::unordered_map<numT, numT> table;
 
-        modNum<numT> basePowed(1, base.getMod());
+        numT alpha = ring.fromModNum(base);
+        numT basePowed = ring.element(1);
         for (numT i = 0; i < m; ++i)
         {
             table.insert({basePowed, i});
-            basePowed = base * basePowed;
+            ring.multAssign(basePowed, alpha);
         }
 
-        modNum<numT> alphaInversed = fpow(base.inv(), m);
-        modNum<numT> gamma = value;
+        numT alphaInversed = ring.pow(ring.inv(alpha), m);
+        numT gamma = ring.element(value.getValue());
 
         for (numT i = 0; i < m; ++i)
         {
-            if (table.find(gamma) != table.end())
+            auto found = table.find(gamma);
+            if (found != table.end())
             {
 
-                return i * m + table[gamma];
+                return i * m + found->second;
             }
-            gamma = gamma * alphaInversed;
+            ring.multAssign(gamma, alphaInversed);
         }
 
         throw std::invalid_argument("Unexpected behaviour");
@@ -0,0 +1,121 @@
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef MOD_NUM_GMP
+#define MOD_NUM_GMP
+
+    /**
+     *  @brief Per-thread scratch register for long products
+     *
+     *  A product can not be formed in place of one of its factors, so GMP would
+     *  allocate a temporary on every in-place multiplication; the register keeps
+     *  its limbs between calls and only grows.
+     *
+     *  @return scratch value of the calling thread
+     */
+    inline mpz_class &gmpScratch()
+    {
+        thread_local mpz_class scratch;
+        return scratch;
+    }
+
+    /**
+     *  @brief Inverts a value into a target register
+     *  @param target result, may alias value
+     *  @param value value to invert
+     *  @param mod modulus
+     *  @throws invalid_argument if the inverse does not exist
+     */
+    inline void gmpInvert(mpz_class &target, const mpz_class &value, const mpz_class &mod)
+    {
+        if (mpz_invert(target.get_mpz_t(), value.get_mpz_t(), mod.get_mpz_t()) == 0)
+        {
+            throw std::invalid_argument("Inverse does not exist here.");
+        }
+    }
+
+    template <>
+    inline mpz_class modNum<mpz_class>::mult(mpz_class value1, mpz_class value2, mpz_class MOD) const
+    {
+        mpz_mul(value1.get_mpz_t(), value1.get_mpz_t(), value2.get_mpz_t());
+        mpz_fdiv_r(value1.get_mpz_t(), value1.get_mpz_t(), MOD.get_mpz_t());
+        return value1;
+    }
+
+    template <>
+    inline void modNum<mpz_class>::setValue(mpz_class _value)
+    {
+        mpz_fdiv_r(value.get_mpz_t(), _value.get_mpz_t(), MOD.get_mpz_t());
+    }
+
+    template <>
+    inline modNum<mpz_class> modNum<mpz_class>::inv()
+    {
+        mpz_class result;
+        gmpInvert(result, value, MOD);
+        return modNum<mpz_class>(std::move(result), MOD, reducedTag());
+    }
+
+    /**
+     *  @brief Residue of another number under a modulus
+     *
+     *  Operands of the same modulus are already reduced and are returned as
+     *  they are; others are reduced into the scratch register.
+     *
+     *  @param value value of the operand
+     *  @param valueMod modulus of the operand
+     *  @param mod modulus of the result
+     *  @return reduced value of the operand
+     */
+    inline const mpz_class &gmpReduced(const mpz_class &value, const mpz_class &valueMod, const mpz_class &mod)
+    {
+        if (valueMod == mod)
+            return value;
+        mpz_class &reduced = gmpScratch();
+        mpz_fdiv_r(reduced.get_mpz_t(), value.get_mpz_t(), mod.get_mpz_t());
+        return reduced;
+    }
+
+    template <>
+    inline modNum<mpz_class> &modNum<mpz_class>::operator+=(const modNum<mpz_class> &other)
+    {
+        mpz_add(value.get_mpz_t(), value.get_mpz_t(), gmpReduced(other.value, other.MOD, MOD).get_mpz_t());
+        if (mpz_cmp(value.get_mpz_t(), MOD.get_mpz_t()) >= 0)
+            mpz_sub(value.get_mpz_t(), value.get_mpz_t(), MOD.get_mpz_t());
+        return *this;
+    }
+
+    template <>
+    inline modNum<mpz_class> &modNum<mpz_class>::operator-=(const modNum<mpz_class> &other)
+    {
+        mpz_sub(value.get_mpz_t(), value.get_mpz_t(), gmpReduced(other.value, other.MOD, MOD).get_mpz_t());
+        if (mpz_sgn(value.get_mpz_t()) < 0)
+            mpz_add(value.get_mpz_t(), value.get_mpz_t(), MOD.get_mpz_t());
+        return *this;
+    }
+
+    /**
+     *  @brief Multiplies in place through the scratch register
+     *  @param other factor with the same modulus
+     *  @return reference to this number
+     */
+    template <>
+    inline modNum<mpz_class> &modNum<mpz_class>::operator*=(const modNum<mpz_class> &other)
+    {
+        mpz_class &product = gmpScratch();
+        mpz_mul(product.get_mpz_t(), value.get_mpz_t(), other.value.get_mpz_t());
+        mpz_tdiv_r(value.get_mpz_t(), product.get_mpz_t(), MOD.get_mpz_t());
+        return *this;
+    }
+
+    template <>
+    inline modNum<mpz_class> &modNum<mpz_class>::operator/=(const modNum<mpz_class> &other)
+    {
+        mpz_class inverse;
+        gmpInvert(inverse, other.value, MOD);
+        return *this *= modNum<mpz_class>(std::move(inverse), MOD, reducedTag());
+    }
+
+#endif
+} // namespace modular
@@ -16,14 +16,21 @@ using namespace modular;
  * @param  value2 The second value to add.
  * @param MOD  The modulo value
  * @return The sum of the two values modulo MOD
- * @throws invalid_argument if MOD is non - positive
+ *
+ * MOD is validated by the constructor and setMod, so it is not checked here.
+ * Built-in values should already be in range [0, MOD).
  */
 template <typename T>
-T modNum<T>::add(T value1, T value2, T MOD) const
+T modNum<T>::add(T value1, T value2, T MOD) const noexcept(std::is_integral<T>::value)
 {
-    if (MOD <= 0)
+    if constexpr (std::is_integral<T>::value)
     {
-        throw invalid_argument("modulus should be positive");
+        // both values are reduced, compare with the gap instead of forming value1 + value2
+        using U = typename std::make_unsigned<T>::type;
+        U gap = static_cast<U>(MOD) - static_cast<U>(value2);
+        if (static_cast<U>(value1) >= gap)
+            return static_cast<T>(static_cast<U>(value1) - gap);
+        return static_cast<T>(static_cast<U>(value1) + static_cast<U>(value2));
     }
     T result = value1 + value2;
     result %= MOD;
@@ -39,14 +46,20 @@ T modNum<T>::add(T value1, T value2, T MOD) const
  *  @param  value2 The second value to be subtracted.
  *  @param MOD The modulo value
  *  @return The result of the subtraction with modulo operation.
- *  @throws invalid_argument if MOD is non-positive
+ *
+ *  Built-in values should already be in range [0, MOD).
  */
 template <typename T>
-T modNum<T>::subs(T value1, T value2, T MOD) const
+T modNum<T>::subs(T value1, T value2, T MOD) const noexcept(std::is_integral<T>::value)
 {
-    if (MOD <= 0)
+    if constexpr (std::is_integral<T>::value)
     {
-        throw invalid_argument("modulus should be positive");
+        // both values are reduced, so one wrap-around of MOD fixes a negative difference
+        using U = typename std::make_unsigned<T>::type;
+        U result = static_cast<U>(value1) - static_cast<U>(value2);
+        if (value1 < value2)
+            result += static_cast<U>(MOD);
+        return static_cast<T>(result);
     }
     T result = value1 - value2;
     result %= MOD;
@@ -62,47 +75,42 @@ T modNum<T>::subs(T value1, T value2, T MOD) const
  *  @param  value2 The second value to multiply.
  *  @param MOD The modulo value
  *  @return The result of the multipilcation with modulo operation.
- *  @throws invalid_argument if MOD is non-positive
  */
 template <typename T>
-T modNum<T>::mult(T value1, T value2, T MOD) const
+T modNum<T>::mult(T value1, T value2, T MOD) const noexcept(std::is_integral<T>::value)
 {
-    if (MOD <= 0)
+    if constexpr (std::is_same<typename reducerType<T>::type, BarrettReducer>::value)
     {
-        throw invalid_argument("modulus should be positive");
+        // the thread keeps the reducer of the last modulus, so only a change of modulus divides
+        return static_cast<T>(sharedReducer(static_cast<uint64_t>(MOD))
+                                  .mult(static_cast<uint64_t>(value1), static_cast<uint64_t>(value2)));
     }
-    value1 = (value1 % MOD + MOD) % MOD;
-    value2 = (value2 % MOD + MOD) % MOD;
-    T result = 0;
-    while (value2)
+    else if constexpr (std::is_integral<T>::value)
     {
-        if (value2 % 2 == 1)
-        {
-            result = (result + value1) % MOD;
-        }
-        value1 = (value1 * 2) % MOD;
-        value2 >>= 1;
+        // values are already reduced, a double-width product can't overflow
+        using wide = typename wideType<T>::type;
+        return static_cast<T>(static_cast<wide>(value1) * static_cast<wide>(value2) % static_cast<wide>(MOD));
     }
-    return result % MOD;
+    T result = value1 * value2;
+    result %= MOD;
+    if (result < 0)
+    {
+        result += MOD;
+    }
+    return result;
 }
+/**
+ *  @brief Calculates the extended GCD of two values
+ *  @param a first value
+ *  @param b second value
+ *  @param x coefficient of a
+ *  @param y coefficient of b
+ *  @return gcd of a and b
+ */
 template <typename T>
 T modNum<T>::gcdExtended(T a, T b, T *x, T *y) const
 {
-    // Base Case
-    if (a == 0)
-    {
-        *x = 0;
-        *y = 1;
-        return b;
-    }
-    T x1, y1; // To store results of recursive call
-    T gcd = gcdExtended(b % a, a, &x1, &y1);
-    // Update x and y using results of
-    // recursive call
-    *x = y1 - (b / a) * x1;
-    *y = x1;
-
-    return gcd;
+    return extendedGcd(a, b, *x, *y);
 }
 
 /**
@@ -115,19 +123,7 @@ T modNum<T>::gcdExtended(T a, T b, T *x, T *y) const
 template <typename T>
 T modNum<T>::inverseValue(T value1, T mod) const
 {
-    T x, y;
-
-    T gcdResult = gcdExtended(value1, mod, &x, &y);
-    if (gcdResult != 1)
-    {
-        string errormsg = "Inverse does not exist here.";
-        throw invalid_argument(errormsg);
-    }
-    else
-    {
-        x = (x % mod + mod) % mod;
-        return x;
-    }
+    return modInverse(value1, mod);
 }
 
 /**
@@ -143,7 +139,7 @@ T modNum<T>::inverseValue(T value1, T mod) const
 template <typename T>
 T modNum<T>::div(T value1, T value2, T mod) const
 {
-    return (value1 * inverseValue(value2, mod)) % mod;
+    return mult(value1, inverseValue(value2, mod), mod);
 }
 
 template <typename T>
@@ -159,43 +155,141 @@ void modNum<T>::setMod(T MOD)
         throw invalid_argument("modulus should be positive");
     }
     this->MOD = MOD;
+    // add and subs expect a value below the modulus
+    setValue(value);
 }
 
 template <typename T>
 void modNum<T>::setValue(T _value)
 {
-    this->value = (((_value % MOD) + MOD) % MOD);
+    this->value = _value % MOD;
+    if (this->value < 0)
+        this->value += MOD;
 }
 
 template <typename T>
 modNum<T>
 modNum<T>::inv()
 {
-    return modNum<T>(inverseValue(value, MOD), MOD);
+    return modNum<T>(inverseValue(value, MOD), MOD, reducedTag());
+}
+/**
+ *  @brief Adds other to this number in place
+ *  @param other number, reduced modulo MOD first if its modulus differs
+ *
+ *  With equal moduli both values are already reduced, so one conditional
+ *  subtraction is enough and long arithmetic types reuse the storage of value.
+ *
+ *  @return reference to this number
+ */
+template <typename T>
+modNum<T> &
+modNum<T>::operator+=(const modNum<T> &other)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        value = add(value, other.MOD == MOD ? other.value : other.value % MOD, MOD);
+    }
+    else
+    {
+        value += other.value;
+        if (value >= MOD)
+            value -= MOD;
+    }
+    return *this;
+}
+
+template <typename T>
+modNum<T> &
+modNum<T>::operator-=(const modNum<T> &other)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        value = subs(value, other.MOD == MOD ? other.value : other.value % MOD, MOD);
+    }
+    else
+    {
+        value -= other.value;
+        if (value < 0)
+            value += MOD;
+    }
+    return *this;
+}
+
+template <typename T>
+modNum<T> &
+modNum<T>::operator*=(const modNum<T> &other)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        value = mult(value, other.value, MOD);
+    }
+    else
+    {
+        value *= other.value;
+        value %= MOD;
+    }
+    return *this;
+}
+
+template <typename T>
+modNum<T> &
+modNum<T>::operator/=(const modNum<T> &other)
+{
+    return *this *= modNum<T>(inverseValue(other.value, MOD), MOD, reducedTag());
+}
+
+template <typename T>
+modNum<T>
+modNum<T>::operator+(const modNum<T> &other) const &
+{
+    return modNum<T>(*this) += other;
 }
 template <typename T>
 modNum<T>
-modNum<T>::operator+(const modNum<T> &other) const
+modNum<T>::operator+(const modNum<T> &other) &&
 {
-    return modNum<T>(add(value, other.value, MOD), MOD);
+    *this += other;
+    return std::move(*this);
 }
 template <typename T>
 modNum<T>
-modNum<T>::operator-(const modNum<T> &other) const
+modNum<T>::operator-(const modNum<T> &other) const &
 {
-    return modNum<T>(subs(value, other.value, MOD), MOD);
+    return modNum<T>(*this) -= other;
 }
 template <typename T>
 modNum<T>
-modNum<T>::operator*(const modNum<T> &other) const
+modNum<T>::operator-(const modNum<T> &other) &&
 {
-    return modNum<T>(mult(value, other.value, MOD), MOD);
+    *this -= other;
+    return std::move(*this);
+}
+template <typename T>
+modNum<T>
+modNum<T>::operator*(const modNum<T> &other) const &
+{
+    return modNum<T>(*this) *= other;
+}
+template <typename T>
+modNum<T>
+modNum<T>::operator*(const modNum<T> &other) &&
+{
+    *this *= other;
+    return std::move(*this);
 }
 
 template <typename T>
 modNum<T>
-modNum<T>::operator/(const modNum<T> &other) const
+modNum<T>::operator/(const modNum<T> &other) const &
+{
+    return modNum<T>(*this) /= other;
+}
+template <typename T>
+modNum<T>
+modNum<T>::operator/(const modNum<T> &other) &&
 {
-    return modNum<T>(div(value, other.value, MOD), MOD);
+    *this /= other;
+    return std::move(*this);
 }
 #endif // TASK2_TCC
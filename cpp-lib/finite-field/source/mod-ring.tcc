@@ -0,0 +1,185 @@
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef MOD_RING
+#define MOD_RING
+
+    /**
+     *  @brief Creates a ring and precomputes reduction constants
+     *  @param _MOD modulus
+     *  @throws invalid_argument if the modulus is non-positive
+     */
+    template <typename T>
+    modRing<T>::modRing(T _MOD) : MOD(_MOD), reducer(makeReducer(MOD))
+    {
+        if (MOD <= 0)
+        {
+            throw std::invalid_argument("modulus should be positive");
+        }
+    }
+
+    template <typename T>
+    T modRing<T>::element(T value) const noexcept(nothrowOps)
+    {
+        value %= MOD;
+        if (value < 0)
+            value += MOD;
+        return value;
+    }
+
+    /**
+     *  @brief Adds two residues
+     *  @param value1 first residue
+     *  @param value2 second residue
+     *
+     *  Built-in types select the correction with a mask instead of a branch,
+     *  and never form value1 + value2, so moduli up to the type limit work.
+     *
+     *  @return sum modulo MOD
+     */
+    template <typename T>
+    T modRing<T>::add(const T &value1, const T &value2) const noexcept(nothrowOps)
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            using U = typename std::make_unsigned<T>::type;
+            U gap = static_cast<U>(MOD) - static_cast<U>(value2);
+            U result = static_cast<U>(value1) - gap;
+            result += static_cast<U>(MOD) & (U(0) - static_cast<U>(static_cast<U>(value1) < gap));
+            return static_cast<T>(result);
+        }
+        else
+        {
+            T result = value1;
+            if (result >= MOD - value2)
+                result -= MOD;
+            result += value2;
+            return result;
+        }
+    }
+
+    template <typename T>
+    T modRing<T>::subs(const T &value1, const T &value2) const noexcept(nothrowOps)
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            using U = typename std::make_unsigned<T>::type;
+            U result = static_cast<U>(value1) - static_cast<U>(value2);
+            result += static_cast<U>(MOD) & (U(0) - static_cast<U>(value1 < value2));
+            return static_cast<T>(result);
+        }
+        else
+        {
+            T result = value1;
+            if (result < value2)
+                result += MOD - value2;
+            else
+                result -= value2;
+            return result;
+        }
+    }
+
+    /**
+     *  @brief Multiplies two residues
+     *  @param value1 first residue
+     *  @param value2 second residue
+     *
+     *  Built-in types reduce the 128-bit product with the Barrett reducer,
+     *  other types with a single division.
+     *
+     *  @return product modulo MOD
+     */
+    template <typename T>
+    T modRing<T>::mult(const T &value1, const T &value2) const noexcept(nothrowOps)
+    {
+        if constexpr (std::is_same<typename reducerType<T>::type, BarrettReducer>::value)
+            return static_cast<T>(reducer.mult(static_cast<uint64_t>(value1), static_cast<uint64_t>(value2)));
+        else
+            return value1 * value2 % MOD;
+    }
+
+    template <typename T>
+    void modRing<T>::addAssign(T &value1, const T &value2) const noexcept(nothrowOps)
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            value1 = add(value1, value2);
+        }
+        else
+        {
+            value1 += value2;
+            if (value1 >= MOD)
+                value1 -= MOD;
+        }
+    }
+
+    template <typename T>
+    void modRing<T>::subsAssign(T &value1, const T &value2) const noexcept(nothrowOps)
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            value1 = subs(value1, value2);
+        }
+        else
+        {
+            value1 -= value2;
+            if (value1 < 0)
+                value1 += MOD;
+        }
+    }
+
+    /**
+     *  @brief Multiplies value1 by value2 in place
+     *  @param value1 residue to update
+     *  @param value2 second factor
+     *
+     *  Long arithmetic types keep the storage of value1, so accumulation
+     *  loops do not allocate once the buffers have grown.
+     */
+    template <typename T>
+    void modRing<T>::multAssign(T &value1, const T &value2) const noexcept(nothrowOps)
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            value1 = mult(value1, value2);
+        }
+        else
+        {
+            value1 *= value2;
+            value1 %= MOD;
+        }
+    }
+
+    template <typename T>
+    T modRing<T>::inv(const T &value) const
+    {
+        return modInverse(value, MOD);
+    }
+
+    template <typename T>
+    T modRing<T>::pow(T value, T power) const
+    {
+        T result = element(1);
+        while (power > 0)
+        {
+            if (power % 2 == 1)
+                multAssign(result, value);
+            multAssign(value, value);
+            power /= 2;
+        }
+        return result;
+    }
+
+    template <typename T>
+    T modRing<T>::fromModNum(const modNum<T> &num) const
+    {
+        if (num.getMod() != MOD)
+        {
+            throw std::invalid_argument("modNum is bound to another modulus");
+        }
+        return num.getValue();
+    }
+
+#endif
+} // namespace modular
@@ -0,0 +1,246 @@
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef MONTGOMERY_CONTEXT
+#define MONTGOMERY_CONTEXT
+
+    /**
+     *  @brief Number of bits of the modulus, R = 2^bits
+     *  @param MOD positive modulus
+     *  @return bit length of MOD
+     */
+    template <typename T>
+    size_t montgomeryBits(T MOD)
+    {
+        if constexpr (std::is_same<T, mpz_class>::value)
+            return mpz_sizeinbase(MOD.get_mpz_t(), 2);
+        size_t bits = 0;
+        while (MOD > 0)
+        {
+            MOD >>= 1;
+            bits++;
+        }
+        return bits;
+    }
+
+    /**
+     *  @brief Precomputes R = 2^k > MOD (the whole word for built-in types), R mod MOD, R^2 mod MOD and -MOD^-1 mod R
+     *  @param _MOD odd modulus
+     *  @throws invalid_argument if the modulus is even, not greater than 1
+     *  or does not leave a spare bit in a built-in type
+     */
+    template <typename T>
+    MontgomeryContext<T>::MontgomeryContext(T _MOD) : MOD(_MOD)
+    {
+        if (MOD <= 1 || MOD % 2 == 0)
+        {
+            throw std::invalid_argument("Montgomery modulus should be odd and greater than 1");
+        }
+
+        rBits = montgomeryBits(MOD);
+        if (std::is_integral<T>::value && rBits >= sizeof(T) * 8)
+        {
+            throw std::invalid_argument("Montgomery modulus is too big for this type");
+        }
+
+        wide n = static_cast<wide>(MOD);
+        if constexpr (std::is_integral<T>::value)
+        {
+            // R is the whole word, so the low half of a product is taken by truncation
+            using U = typename std::make_unsigned<T>::type;
+            rBits = sizeof(T) * 8;
+            U x = 1;
+            for (size_t bits = 1; bits < rBits; bits *= 2)
+                x *= static_cast<U>(2) - static_cast<U>(MOD) * x;
+            nPrime = static_cast<wide>(static_cast<U>(0) - x);
+        }
+
+        R = static_cast<wide>(1) << rBits;
+        mask = R - 1;
+
+        if constexpr (!std::is_integral<T>::value)
+        {
+            // Newton iteration for MOD^-1 mod R, every step doubles the number of correct bits
+            wide x = 1;
+            for (size_t bits = 1; bits < rBits; bits *= 2)
+            {
+                wide t = (n * x) & mask;
+                x = (x * ((R + 2 - t) & mask)) & mask;
+            }
+            nPrime = (R - x) & mask;
+        }
+
+        wide r = R % n;
+        rModN = static_cast<T>(r);
+        rSquared = static_cast<T>((r * r) % n);
+    }
+
+    template <typename T>
+    bool MontgomeryContext<T>::supports(const T &_MOD)
+    {
+        if (_MOD <= 1 || _MOD % 2 == 0)
+            return false;
+        return !std::is_integral<T>::value || montgomeryBits(_MOD) < sizeof(T) * 8;
+    }
+
+    /**
+     *  @brief Montgomery reduction
+     *  @param t value in range [0, MOD * R)
+     *  @return t * R^-1 mod MOD
+     */
+    template <typename T>
+    T MontgomeryContext<T>::REDC(const wide &t) const
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            // t + m * MOD < 2 * MOD * R fits the unsigned wide type, as MOD has a spare bit
+            using U = typename std::make_unsigned<T>::type;
+            using UW = typename wideType<U>::type;
+            U m = static_cast<U>(t) * static_cast<U>(nPrime);
+            U u = static_cast<U>((static_cast<UW>(t) + static_cast<UW>(m) * static_cast<UW>(MOD)) >> rBits);
+            // u < 2 * MOD, the wrapped difference is larger than u exactly when u < MOD
+            return static_cast<T>(std::min<U>(u, u - static_cast<U>(MOD)));
+        }
+        wide m = ((t & mask) * nPrime) & mask;
+        wide u = (t + m * static_cast<wide>(MOD)) >> rBits;
+        if (u >= static_cast<wide>(MOD))
+            u -= static_cast<wide>(MOD);
+        return static_cast<T>(u);
+    }
+
+    template <typename T>
+    T MontgomeryContext<T>::toMontgomery(T value) const
+    {
+        value %= MOD;
+        if (value < 0)
+            value += MOD;
+        return REDC(static_cast<wide>(value) * static_cast<wide>(rSquared));
+    }
+
+    /**
+     *  @brief Multiplies two values in Montgomery form
+     *  @param value1 first factor in Montgomery form
+     *  @param value2 second factor in Montgomery form
+     *  @return product in Montgomery form, one REDC per call
+     */
+    template <typename T>
+    T MontgomeryContext<T>::mult(T value1, T value2) const
+    {
+        if constexpr (std::is_integral<T>::value)
+        {
+            // residues are non-negative, an unsigned product needs a single mul instruction
+            using U = typename std::make_unsigned<T>::type;
+            using UW = typename wideType<U>::type;
+            return REDC(static_cast<wide>(static_cast<UW>(static_cast<U>(value1)) * static_cast<U>(value2)));
+        }
+        return REDC(static_cast<wide>(value1) * static_cast<wide>(value2));
+    }
+
+    template <typename T>
+    T MontgomeryContext<T>::add(T value1, T value2) const
+    {
+        wide result = static_cast<wide>(value1) + static_cast<wide>(value2);
+        if (result >= static_cast<wide>(MOD))
+            result -= static_cast<wide>(MOD);
+        return static_cast<T>(result);
+    }
+
+    template <typename T>
+    T MontgomeryContext<T>::subs(T value1, T value2) const
+    {
+        if (value1 >= value2)
+            return value1 - value2;
+        return static_cast<T>(static_cast<wide>(value1) + static_cast<wide>(MOD) - static_cast<wide>(value2));
+    }
+
+    template <typename T>
+    T MontgomeryContext<T>::fromModNum(const modNum<T> &num) const
+    {
+        if (num.getMod() != MOD)
+        {
+            throw std::invalid_argument("modNum is bound to another modulus");
+        }
+        return toMontgomery(num.getValue());
+    }
+
+    /**
+     *  @brief Montgomery reduction on preallocated registers
+     *  @param t value in range [0, MOD * R)
+     *
+     *  The generic version builds an mpz_class temporary for every step of the
+     *  expression; here the masks and shifts are single GMP calls on registers
+     *  that keep their limbs between calls.
+     *
+     *  @return t * R^-1 mod MOD
+     */
+    template <>
+    inline mpz_class MontgomeryContext<mpz_class>::REDC(const mpz_class &t) const
+    {
+        thread_local mpz_class m;
+        mpz_tdiv_r_2exp(m.get_mpz_t(), t.get_mpz_t(), rBits);
+        mpz_mul(m.get_mpz_t(), m.get_mpz_t(), nPrime.get_mpz_t());
+        mpz_tdiv_r_2exp(m.get_mpz_t(), m.get_mpz_t(), rBits);
+        mpz_mul(m.get_mpz_t(), m.get_mpz_t(), MOD.get_mpz_t());
+        mpz_add(m.get_mpz_t(), m.get_mpz_t(), t.get_mpz_t());
+        mpz_class u;
+        mpz_tdiv_q_2exp(u.get_mpz_t(), m.get_mpz_t(), rBits);
+        if (mpz_cmp(u.get_mpz_t(), MOD.get_mpz_t()) >= 0)
+            mpz_sub(u.get_mpz_t(), u.get_mpz_t(), MOD.get_mpz_t());
+        return u;
+    }
+
+    template <>
+    inline mpz_class MontgomeryContext<mpz_class>::mult(mpz_class value1, mpz_class value2) const
+    {
+        mpz_mul(value1.get_mpz_t(), value1.get_mpz_t(), value2.get_mpz_t());
+        return REDC(value1);
+    }
+
+    template <typename T>
+    montgomeryNum<T>
+    montgomeryNum<T>::inv() const
+    {
+        return montgomeryNum(*context, modInverse(getValue(), context->getMod()));
+    }
+
+    template <typename T>
+    montgomeryNum<T> &
+    montgomeryNum<T>::operator+=(const montgomeryNum<T> &other)
+    {
+        value = context->add(value, other.value);
+        return *this;
+    }
+
+    template <typename T>
+    montgomeryNum<T> &
+    montgomeryNum<T>::operator-=(const montgomeryNum<T> &other)
+    {
+        value = context->subs(value, other.value);
+        return *this;
+    }
+
+    template <typename T>
+    montgomeryNum<T> &
+    montgomeryNum<T>::operator*=(const montgomeryNum<T> &other)
+    {
+        value = context->mult(value, other.value);
+        return *this;
+    }
+
+    template <typename T>
+    montgomeryNum<T>
+    fpow(montgomeryNum<T> value, T power)
+    {
+        if (value.value == 0 && power == 0)
+        {
+            throw std::invalid_argument("0 pow 0 is undefined");
+        }
+        const MontgomeryContext<T> &ctx = *value.context;
+        T result = slidingWindowPow(value.value, power, ctx.one(),
+                                    [&ctx](T &a, const T &b) { a = ctx.mult(a, b); });
+        return montgomeryNum<T>(ctx, std::move(result), typename montgomeryNum<T>::formTag());
+    }
+
+#endif
+} // namespace modular
@@ -0,0 +1,80 @@
+#include "../mod-math.h"
+#include "fpow.tcc"
+
+namespace modular
+{
+#ifndef MULTI_POW
+#define MULTI_POW
+
+    /**
+     *  @brief Computes the product of powers with one shared squaring chain
+     *  @param terms (base, exponent) pairs
+     *
+     *  Each base gets its own table of odd powers, sized by the length of its exponent.
+     *  The chain runs from the top bit of the longest exponent, squares once per bit
+     *  and multiplies by a table entry wherever a window of some term ends.
+     *
+     *  @return product of base^exponent over the terms
+     */
+    template <typename T>
+    modNum<T> multiPow(const std::vector<std::pair<modNum<T>, T>> &terms)
+    {
+        if (terms.empty())
+        {
+            throw std::invalid_argument("multi-exponentiation needs at least one term");
+        }
+        T MOD = terms.front().first.getMod();
+        for (const auto &term : terms)
+        {
+            if (term.first.getMod() != MOD)
+            {
+                throw std::invalid_argument("bases should share one modulus");
+            }
+            if (term.first.getValue() == 0 && term.second == 0)
+            {
+                throw std::invalid_argument("0 pow 0 is undefined");
+            }
+        }
+
+        modRing<T> ring(MOD);
+        size_t bits = 0;
+        std::vector<std::vector<size_t>> digits(terms.size());
+        std::vector<std::vector<T>> oddPowers(terms.size());
+        for (size_t t = 0; t < terms.size(); ++t)
+        {
+            size_t window = slidingWindowSize(exponentBitLength(terms[t].second));
+            digits[t] = slidingWindowDigits(terms[t].second, window);
+            bits = std::max(bits, digits[t].size());
+
+            const T &base = terms[t].first.getValue();
+            std::vector<T> &table = oddPowers[t];
+            table.assign(static_cast<size_t>(1) << (window - 1), base);
+            if (table.size() > 1)
+            {
+                T square = ring.mult(base, base);
+                for (size_t i = 1; i < table.size(); ++i)
+                    table[i] = ring.mult(table[i - 1], square);
+            }
+        }
+
+        T result = ring.element(1);
+        bool started = false;
+        for (size_t i = bits; i > 0; --i)
+        {
+            size_t position = i - 1;
+            if (started)
+                ring.multAssign(result, result);
+            for (size_t t = 0; t < terms.size(); ++t)
+            {
+                if (position < digits[t].size() && digits[t][position] != 0)
+                {
+                    ring.multAssign(result, oddPowers[t][digits[t][position] / 2]);
+                    started = true;
+                }
+            }
+        }
+        return ring.toModNum(result);
+    }
+
+#endif
+} // namespace modular
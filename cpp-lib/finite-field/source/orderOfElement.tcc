@@ -1,7 +1,7 @@
 #include <map>
 #include <utility>
 
-#include "factorization.tcc"
+#include "factor-cache.tcc"
 #include "mod-num.tcc"
 
 namespace modular
@@ -22,24 +22,19 @@ namespace modular
 
         modNum<T> a1, one(static_cast<T>(1), a.getMod());
 
-        vector<modNum<T>> factors = factorize(modNum<T>(t - 1, t + 1));
-
-        std::map<modNum<T>, size_t> factorsCombined;
-
-        for (auto factor : factors)
-        {
-            factorsCombined[factor]++;
-        }
+        std::map<T, unsigned> factorsCombined = cachedFactorization(static_cast<T>(t - 1));
+        t = t - 1;
 
         for (auto num : factorsCombined)
         {
-            t = t / fpow(num.first, static_cast<T>(num.second)).getValue();
+            for (unsigned i = 0; i < num.second; ++i)
+                t = t / num.first;
             a1 = fpow(a, t);
 
             while (!(a1 == one))
             {
-                a1 = fpow(a1, num.first.getValue());
-                t = (t * num.first.getValue()) % num.first.getMod();
+                a1 = fpow(a1, num.first);
+                t = t * num.first;
             }
         }
 
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef PARALLEL_FOR
+#define PARALLEL_FOR
+
+    /**
+     *  @brief Number of workers for a batch
+     *  @param requested wanted number of workers, 0 for one per hardware thread
+     *  @param tasks number of independent tasks
+     *  @return worker count in range [1, max(tasks, 1)]
+     */
+    inline size_t workerCount(size_t requested, size_t tasks)
+    {
+        if (requested == 0)
+            requested = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        return std::max<size_t>(std::min(requested, tasks), 1);
+    }
+
+    /**
+     *  @brief Splits [0, count) into contiguous chunks and runs them on a pool of threads
+     *  @param count number of tasks
+     *  @param threads wanted number of workers, 0 for one per hardware thread
+     *  @param body function (begin, end) processing one chunk
+     *
+     *  The calling thread takes the first chunk. If a thread can not be started
+     *  (e.g. a build without thread support) its chunk runs on the caller.
+     *  The first exception thrown by a chunk is rethrown after all workers finished.
+     *
+     *  Every chunk runs with the thread generator reseeded from one draw of the
+     *  caller and the index of the chunk, so the random values of a chunk do not
+     *  depend on which thread runs it or when; the caller's generator is restored
+     *  afterwards and advances by that single draw.
+     */
+    template <typename F>
+    void parallelFor(size_t count, size_t threads, const F &body)
+    {
+        size_t workers = workerCount(threads, count);
+        if (workers == 1)
+        {
+            if (count > 0)
+                body(0, count);
+            return;
+        }
+
+        size_t chunk = (count + workers - 1) / workers;
+        std::vector<std::exception_ptr> errors(workers);
+        uint64_t seed = threadRandom()();
+        auto run = [&](size_t worker)
+        {
+            size_t begin = std::min(count, worker * chunk), end = std::min(count, begin + chunk);
+            randomGenerator &generator = threadRandom();
+            randomGenerator saved = generator;
+            generator.seed(seed + worker * 0x9e3779b97f4a7c15ULL);
+            try
+            {
+                if (begin < end)
+                    body(begin, end);
+            }
+            catch (...)
+            {
+                errors[worker] = std::current_exception();
+            }
+            generator = saved;
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (size_t worker = 1; worker < workers; ++worker)
+        {
+            try
+            {
+                pool.emplace_back(run, worker);
+            }
+            catch (const std::system_error &)
+            {
+                run(worker);
+            }
+        }
+        run(0);
+        for (std::thread &thread : pool)
+            thread.join();
+
+        for (const std::exception_ptr &error : errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+    }
+
+#endif
+} // namespace modular
@@ -0,0 +1,376 @@
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "../mod-math.h"
+#include "factorization.tcc"
+#include "sieve.tcc"
+
+namespace modular
+{
+#ifndef POLLARD_WILLIAMS
+#define POLLARD_WILLIAMS
+
+    /**
+     *  @brief Lists the primes up to a bound
+     *  @param limit inclusive bound
+     *  @return primes in increasing order
+     */
+    inline std::vector<uint64_t> primesUpTo(uint64_t limit)
+    {
+        std::vector<uint64_t> primes;
+        if (limit < 2)
+            return primes;
+        for (uint64_t p : primeRange(2, limit + 1))
+            primes.push_back(p);
+        return primes;
+    }
+
+    /**
+     *  @brief Computes the Lucas sequence value V_k(x) modulo n
+     *  @param result receives V_k, with V_0 = 2, V_1 = x and V_(j+1) = x V_j - V_(j-1)
+     *
+     *  The ladder keeps (V_j, V_(j+1)) and uses V_2j = V_j^2 - 2, V_(2j+1) = V_j V_(j+1) - x,
+     *  so V_k(V_m(x)) = V_km(x) lets stage 1 apply one prime power at a time.
+     */
+    inline void lucasV(mpz_class &result, const mpz_class &x, uint64_t k, const mpz_class &n)
+    {
+        if (k == 0)
+        {
+            result = 2;
+            return;
+        }
+        mpz_class u = x, v = x * x - 2;
+        mpz_mod(v.get_mpz_t(), v.get_mpz_t(), n.get_mpz_t());
+        int top = 63;
+        while (((k >> top) & 1) == 0)
+            --top;
+        for (int bit = top - 1; bit >= 0; --bit)
+        {
+            if ((k >> bit) & 1)
+            {
+                u = u * v - x;
+                v = v * v - 2;
+            }
+            else
+            {
+                v = u * v - x;
+                u = u * u - 2;
+            }
+            mpz_mod(u.get_mpz_t(), u.get_mpz_t(), n.get_mpz_t());
+            mpz_mod(v.get_mpz_t(), v.get_mpz_t(), n.get_mpz_t());
+        }
+        result = u;
+    }
+
+    /**
+     *  @brief Stage 2 shared by p - 1 and p + 1 with the prime-pairing continuation
+     *  @param n modulus
+     *  @param w V_1 of the stage 1 result: a + a^-1 for p - 1, the Lucas value for p + 1
+     *  @param primes primes in increasing order, covering (B1, B2]
+     *
+     *  A prime q in (B1, B2] is written as m D +- j with j < D / 2 coprime to D. Since
+     *  V_mD - V_j vanishes modulo p when the group order divides m D - j or m D + j,
+     *  one multiplication covers both primes of a pair.
+     *
+     *  @return gcd of the accumulated product with n
+     */
+    inline mpz_class smoothStageTwo(const mpz_class &n, const mpz_class &w, const std::vector<uint64_t> &primes,
+                                    uint64_t B1, uint64_t B2)
+    {
+        const uint64_t D = B2 - B1 > 1000000 ? 2310 : 210;
+        B1 = std::max<uint64_t>(B1, 11);
+        auto first = std::upper_bound(primes.begin(), primes.end(), B1);
+        if (first == primes.end() || *first > B2)
+            return 1;
+
+        // baby steps V_j for odd j < D / 2, kept when j is coprime to D
+        std::vector<mpz_class> baby(D / 2);
+        mpz_class v2 = w * w - 2, previous = w, current = w, next;
+        mpz_mod(v2.get_mpz_t(), v2.get_mpz_t(), n.get_mpz_t());
+        baby[1] = w;
+        for (uint64_t j = 3; j < D / 2; j += 2)
+        {
+            next = current * v2 - previous;
+            mpz_mod(next.get_mpz_t(), next.get_mpz_t(), n.get_mpz_t());
+            previous = current;
+            current = next;
+            if (std::gcd(j, D) == 1)
+                baby[j] = current;
+        }
+
+        // giant steps V_mD, advanced with V_(m+1)D = V_mD V_D - V_(m-1)D
+        uint64_t m = (*first + D / 2) / D;
+        mpz_class giantStep, giant, before;
+        lucasV(giantStep, w, D, n);
+        lucasV(giant, w, m * D, n);
+        if (m == 0)
+            before = giantStep;
+        else
+            lucasV(before, w, (m - 1) * D, n);
+
+        std::vector<char> done(D / 2, 0);
+        mpz_class product = 1, difference;
+        for (auto it = first; it != primes.end() && *it <= B2; ++it)
+        {
+            uint64_t q = *it, mq = (q + D / 2) / D;
+            while (m < mq)
+            {
+                next = giant * giantStep - before;
+                mpz_mod(next.get_mpz_t(), next.get_mpz_t(), n.get_mpz_t());
+                before = giant;
+                giant = next;
+                ++m;
+                std::fill(done.begin(), done.end(), 0);
+            }
+            uint64_t j = q > m * D ? q - m * D : m * D - q;
+            if (done[j])
+                continue;
+            done[j] = 1;
+            difference = giant - baby[j];
+            product *= difference;
+            mpz_mod(product.get_mpz_t(), product.get_mpz_t(), n.get_mpz_t());
+        }
+        return ::gcd(product, n);
+    }
+
+    /**
+     *  @brief Looks for a prime p of n with smooth p - 1 (Pollard's p - 1 method)
+     *  @param n odd composite
+     *  @param primes primes in increasing order up to B2
+     *  @param B1 stage 1 bound, every prime power up to B1 goes into the exponent
+     *  @param B2 stage 2 bound, one more prime up to B2 is allowed
+     *
+     *  Stage 1 raises 2 to the product of the prime powers, a few thousand bits at a time.
+     *  If every prime of n is caught at once the powers are replayed one by one.
+     *
+     *  @return a proper divisor of n, or 1
+     */
+    inline mpz_class pm1FindFactor(const mpz_class &n, const std::vector<uint64_t> &primes, uint64_t B1, uint64_t B2)
+    {
+        if (n < 4 || mpz_even_p(n.get_mpz_t()))
+            return n % 2 == 0 && n > 2 ? mpz_class(2) : mpz_class(1);
+
+        mpz_class a = 2, exponent = 1, g;
+        for (auto it = primes.begin(); it != primes.end() && *it <= B1; ++it)
+        {
+            uint64_t power = *it;
+            while (power <= B1 / *it)
+                power *= *it;
+            exponent *= static_cast<unsigned long>(power);
+            if (mpz_sizeinbase(exponent.get_mpz_t(), 2) > 4096)
+            {
+                mpz_powm(a.get_mpz_t(), a.get_mpz_t(), exponent.get_mpz_t(), n.get_mpz_t());
+                exponent = 1;
+            }
+        }
+        mpz_powm(a.get_mpz_t(), a.get_mpz_t(), exponent.get_mpz_t(), n.get_mpz_t());
+        g = ::gcd(mpz_class(a - 1), n);
+
+        if (g == n)
+        {
+            a = 2;
+            for (auto it = primes.begin(); it != primes.end() && *it <= B1; ++it)
+            {
+                for (uint64_t power = *it; power <= B1; power *= *it)
+                {
+                    mpz_powm_ui(a.get_mpz_t(), a.get_mpz_t(), *it, n.get_mpz_t());
+                    g = ::gcd(mpz_class(a - 1), n);
+                    if (g != 1)
+                        return g != n ? g : mpz_class(1);
+                    if (power > B1 / *it)
+                        break;
+                }
+            }
+            return 1;
+        }
+        if (g != 1)
+            return g;
+
+        mpz_class inverse;
+        mpz_invert(inverse.get_mpz_t(), a.get_mpz_t(), n.get_mpz_t());
+        mpz_class w = a + inverse;
+        mpz_mod(w.get_mpz_t(), w.get_mpz_t(), n.get_mpz_t());
+        g = smoothStageTwo(n, w, primes, B1, B2);
+        return g != n ? g : mpz_class(1);
+    }
+
+    /**
+     *  @brief Looks for a prime p of n with smooth p + 1 (Williams' p + 1 method)
+     *  @param n odd composite
+     *  @param primes primes in increasing order up to B2
+     *  @param B1 stage 1 bound
+     *  @param B2 stage 2 bound
+     *  @param seed starting value V_1; the method works on p + 1 when seed^2 - 4
+     *  is a non-residue modulo p and on p - 1 otherwise
+     *
+     *  @return a proper divisor of n, or 1
+     */
+    inline mpz_class pp1FindFactor(const mpz_class &n, const std::vector<uint64_t> &primes, uint64_t B1, uint64_t B2,
+                                   const mpz_class &seed)
+    {
+        if (n < 4 || mpz_even_p(n.get_mpz_t()))
+            return n % 2 == 0 && n > 2 ? mpz_class(2) : mpz_class(1);
+
+        mpz_class x = seed % n;
+        if (x < 0)
+            x += n;
+        for (auto it = primes.begin(); it != primes.end() && *it <= B1; ++it)
+        {
+            uint64_t power = *it;
+            while (power <= B1 / *it)
+                power *= *it;
+            lucasV(x, x, power, n);
+        }
+        mpz_class g = ::gcd(mpz_class(x - 2), n);
+        if (g == 1)
+            g = smoothStageTwo(n, x, primes, B1, B2);
+        return g != n ? g : mpz_class(1);
+    }
+
+    /**
+     *  @brief Runs p + 1 with the seeds 2/7, 6/5 and 3/11 in turn
+     *
+     *  These seeds make seed^2 - 4 a non-residue for more primes than a random choice.
+     *
+     *  @return a proper divisor of n, or 1
+     */
+    inline mpz_class pp1Seeds(const mpz_class &n, const std::vector<uint64_t> &primes, uint64_t B1, uint64_t B2)
+    {
+        static const unsigned long seeds[][2] = {{2, 7}, {6, 5}, {3, 11}};
+        for (const auto &fraction : seeds)
+        {
+            mpz_class seed = fraction[1];
+            if (mpz_invert(seed.get_mpz_t(), seed.get_mpz_t(), n.get_mpz_t()) == 0)
+            {
+                mpz_class g = ::gcd(mpz_class(fraction[1]), n);
+                return g != n ? g : mpz_class(1);
+            }
+            seed = seed * fraction[0] % n;
+            mpz_class g = pp1FindFactor(n, primes, B1, B2, seed);
+            if (g != 1)
+                return g;
+        }
+        return 1;
+    }
+
+    /**
+     *  @brief Cheap p - 1 pass with B1 = 10^4 and B2 = 10^6 run before ECM and SIQS
+     *  @return a proper divisor of n, or 1
+     */
+    inline mpz_class smoothFirstPass(const mpz_class &n)
+    {
+        static const std::vector<uint64_t> primes = primesUpTo(1000000);
+        return pm1FindFactor(n, primes, 10000, 1000000);
+    }
+
+    template <typename T1>
+    template <typename T2>
+    modNum<T1>::PMinus1<T2>::PMinus1(uint64_t _B1, uint64_t _B2)
+        : B1(_B1), B2(_B2 == 0 ? 100 * _B1 : std::max(_B1, _B2)), primes(primesUpTo(B2))
+    {
+    }
+
+    template <typename T1>
+    template <typename T2>
+    modNum<T1>::PPlus1<T2>::PPlus1(uint64_t _B1, uint64_t _B2)
+        : B1(_B1), B2(_B2 == 0 ? 100 * _B1 : std::max(_B1, _B2)), primes(primesUpTo(B2))
+    {
+    }
+
+    /**
+     *  @brief Splits off small primes, prime and square values, and calls search on the rest
+     *  @param value number
+     *  @param search function (mpz_class) returning a proper divisor or 1
+     *  @param firstPass run smoothFirstPass before search
+     *
+     *  Values that fit a word, and values search could not split, go to Pollard's rho.
+     *
+     *  @return vector of factors
+     */
+    template <typename T, typename Search>
+    std::vector<T> smoothFactor(T value, const Search &search, bool firstPass)
+    {
+        if (value < 1)
+            throw std::invalid_argument("value is less than 1");
+
+        std::vector<T> factors;
+        value = stripSmallPrimes(value, [&factors](const T &p, unsigned exponent)
+                                 { factors.insert(factors.end(), exponent, p); });
+        if (value == 1)
+            return factors;
+        if (isPrimeValue(value))
+        {
+            factors.push_back(value);
+            return factors;
+        }
+
+        T divisor = 1;
+        if (!::exactSquareRoot(value, divisor))
+        {
+            divisor = 1;
+            if constexpr (std::is_same<T, mpz_class>::value)
+            {
+                if (mpz_sizeinbase(value.get_mpz_t(), 2) > 64)
+                {
+                    if (firstPass)
+                        divisor = smoothFirstPass(value);
+                    if (divisor == 1)
+                        divisor = search(value);
+                }
+            }
+            if (divisor == 1)
+                divisor = ::pollardRhO(value);
+        }
+        for (T part : {divisor, T(value / divisor)})
+        {
+            std::vector<T> tmp = smoothFactor(part, search, firstPass);
+            factors.insert(factors.end(), tmp.begin(), tmp.end());
+        }
+        return factors;
+    }
+
+    /**
+     *  @brief Factorization using Pollard's p - 1 method
+     *  @param value number
+     *  @return vector of factors
+     */
+    template <typename T1>
+    template <typename T2>
+    std::vector<T2> modNum<T1>::PMinus1<T2>::factor(T2 value)
+    {
+        // the search is a p - 1 pass itself, with bounds at least those of the first pass
+        return smoothFactor(
+            value, [this](const mpz_class &n) { return pm1FindFactor(n, primes, B1, B2); }, false);
+    }
+
+    /**
+     *  @brief Factorization using Williams' p + 1 method
+     *  @param value number
+     *  @return vector of factors
+     */
+    template <typename T1>
+    template <typename T2>
+    std::vector<T2> modNum<T1>::PPlus1<T2>::factor(T2 value)
+    {
+        return smoothFactor(value, [this](const mpz_class &n) { return pp1Seeds(n, primes, B1, B2); });
+    }
+
+    template <typename T1>
+    std::vector<modNum<T1>> pm1Factorize(modNum<T1> value, uint64_t B1)
+    {
+        typename modNum<T1>::template PMinus1<T1> strat(B1);
+        Adapter<T1> adapter(value.getValue(), value.getMod());
+        return adapter.factorizeMod(&strat);
+    }
+
+    template <typename T1>
+    std::vector<modNum<T1>> pp1Factorize(modNum<T1> value, uint64_t B1)
+    {
+        typename modNum<T1>::template PPlus1<T1> strat(B1);
+        Adapter<T1> adapter(value.getValue(), value.getMod());
+        return adapter.factorizeMod(&strat);
+    }
+
+#endif
+} // namespace modular
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "../mod-math.h"
+#include "fpow.tcc"
+#include "isPrime.tcc"
+#include "parallel.tcc"
+#include "random.tcc"
+#include "small-primes.tcc"
+
+namespace modular
+{
+#ifndef PRIME_SEARCH
+#define PRIME_SEARCH
+
+    /**
+     *  @brief Converts a small non-negative value to size_t
+     *  @param value value, should fit size_t
+     *  @return value as size_t
+     */
+    template <typename T>
+    size_t searchOffset(const T &value)
+    {
+        if constexpr (std::is_same<T, mpz_class>::value)
+            return value.get_ui();
+        else
+            return static_cast<size_t>(value);
+    }
+
+    /**
+     *  @brief Non-negative remainder by a small prime
+     *  @param value value
+     *  @param prime divisor
+     *  @return value mod prime in range [0, prime)
+     */
+    template <typename T>
+    uint64_t smallResidue(const T &value, uint32_t prime)
+    {
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            return mpz_fdiv_ui(value.get_mpz_t(), prime);
+        }
+        else
+        {
+            T r = value % static_cast<T>(prime);
+            if (r < 0)
+                r += prime;
+            return static_cast<uint64_t>(r);
+        }
+    }
+
+    /**
+     *  @brief Sieves a window of consecutive values by the small-prime table
+     *  @param start first value
+     *  @param length number of values
+     *
+     *  Every prime of the table crosses off its multiples from 2p on, with one
+     *  remainder per prime for the whole window.
+     *
+     *  @return entry i is 0 if start + i is below 2 or has a table prime as a proper factor
+     */
+    template <typename T>
+    std::vector<uint8_t> sieveWindow(const T &start, size_t length)
+    {
+        std::vector<uint8_t> candidate(length, 1);
+        size_t skip = 0;
+        if (start < 2)
+            skip = std::min(length, searchOffset(T(2 - start)));
+        std::fill(candidate.begin(), candidate.begin() + skip, 0);
+        if (skip == length)
+            return candidate;
+
+        T first = start + static_cast<T>(skip);
+        for (const smallPrime &entry : smallPrimeTable)
+        {
+            uint64_t p = entry.prime;
+            size_t i;
+            if (first <= static_cast<T>(p))
+                i = searchOffset(T(static_cast<T>(2 * p) - first));
+            else
+                i = static_cast<size_t>((p - smallResidue(first, entry.prime)) % p);
+            for (i += skip; i < length; i += p)
+                candidate[i] = 0;
+        }
+        return candidate;
+    }
+
+    /**
+     *  @brief Length of the windows scanned by nextPrime and prevPrime
+     *  @param value starting point
+     *  @return a few average prime gaps around value
+     */
+    template <typename T>
+    size_t searchWindow(const T &value)
+    {
+        return std::max<size_t>(64, 16 * exponentBitLength(value));
+    }
+
+    template <typename T>
+    T nextPrime(const T &value)
+    {
+        if (value < 2)
+            return 2;
+        if constexpr (std::is_integral<T>::value)
+        {
+            if (value == std::numeric_limits<T>::max())
+            {
+                throw std::invalid_argument("no prime above value fits the type");
+            }
+        }
+
+        T start = value + 1;
+        while (true)
+        {
+            size_t length = searchWindow(start);
+            bool last = false;
+            if constexpr (std::is_integral<T>::value)
+            {
+                uint64_t room = static_cast<uint64_t>(std::numeric_limits<T>::max() - start);
+                if (room < length)
+                {
+                    length = static_cast<size_t>(room) + 1;
+                    last = true;
+                }
+            }
+
+            std::vector<uint8_t> candidate = sieveWindow(start, length);
+            for (size_t i = 0; i < length; ++i)
+            {
+                if (candidate[i] && isPrimeValue(T(start + static_cast<T>(i))))
+                    return start + static_cast<T>(i);
+            }
+            if (last)
+            {
+                throw std::invalid_argument("no prime above value fits the type");
+            }
+            start += static_cast<T>(length);
+        }
+    }
+
+    template <typename T>
+    T prevPrime(const T &value)
+    {
+        if (value <= 2)
+        {
+            throw std::invalid_argument("there is no prime below value");
+        }
+
+        T end = value;
+        while (true)
+        {
+            size_t length = searchWindow(end);
+            if (end < static_cast<T>(length) + 2)
+                length = searchOffset(T(end - 2));
+            T start = end - static_cast<T>(length);
+
+            std::vector<uint8_t> candidate = sieveWindow(start, length);
+            for (size_t i = length; i > 0; --i)
+            {
+                if (candidate[i - 1] && isPrimeValue(T(start + static_cast<T>(i - 1))))
+                    return start + static_cast<T>(i - 1);
+            }
+            end = start;
+        }
+    }
+
+    /**
+     *  @brief Draws a random prime of an exact bit length
+     *  @param bits bit length
+     *
+     *  Odd candidates are drawn uniformly until one passes the table and the primality test,
+     *  so every prime of the range except 2 is equally likely.
+     *
+     *  @return prime in range [2^(bits - 1), 2^bits)
+     */
+    template <typename T>
+    T randomPrime(size_t bits)
+    {
+        if (bits < 2)
+        {
+            throw std::invalid_argument("a prime has at least 2 bits");
+        }
+        if constexpr (std::is_integral<T>::value)
+        {
+            if (bits > static_cast<size_t>(std::numeric_limits<T>::digits))
+            {
+                throw std::invalid_argument("bit length does not fit the type");
+            }
+        }
+
+        T low = static_cast<T>(1);
+        low <<= bits - 1;
+        T high = low + (low - 1);
+        while (true)
+        {
+            T candidate = randomRange(low, high) | static_cast<T>(1);
+            if (smallPrimeFilter(candidate) != sieveVerdict::composite && isPrimeValue(candidate))
+                return candidate;
+        }
+    }
+
+    template <typename T>
+    std::vector<bool> isPrimeBatch(const std::vector<T> &values, size_t threads)
+    {
+        std::vector<uint8_t> prime(values.size());
+        parallelFor(values.size(), threads,
+                    [&values, &prime](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            prime[i] = isPrimeValue(values[i]);
+                    });
+        return std::vector<bool>(prime.begin(), prime.end());
+    }
+
+    template <typename T>
+    std::vector<bool> primeBitmap(const T &lo, const T &hi, size_t threads)
+    {
+        if (hi <= lo)
+            return {};
+        size_t length = searchOffset(T(hi - lo));
+
+        std::vector<uint8_t> prime = sieveWindow(lo, length);
+        parallelFor(length, threads,
+                    [&lo, &prime](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            if (prime[i])
+                                prime[i] = isPrimeValue(T(lo + static_cast<T>(i)));
+                        }
+                    });
+        return std::vector<bool>(prime.begin(), prime.end());
+    }
+
+#endif
+} // namespace modular
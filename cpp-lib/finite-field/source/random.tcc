@@ -0,0 +1,169 @@
+#include <atomic>
+#include <random>
+#include <vector>
+
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef RANDOM_GENERATOR
+#define RANDOM_GENERATOR
+
+    /**
+     *  @brief splitmix64 step, spreads a seed over the whole word
+     *  @param x state, advanced by the golden gamma
+     *  @return next output
+     */
+    inline uint64_t splitMix64(uint64_t &x) noexcept
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    inline void randomGenerator::seed(uint64_t seed) noexcept
+    {
+        for (uint64_t &word : state)
+            word = splitMix64(seed);
+    }
+
+    inline uint64_t randomGenerator::operator()() noexcept
+    {
+        auto rotl = [](uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+        uint64_t result = rotl(state[0] + state[3], 23) + state[0];
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /**
+     *  @brief Library seed, random unless set by setRandomSeed
+     */
+    inline std::atomic<uint64_t> &librarySeed()
+    {
+        static std::atomic<uint64_t> seed((static_cast<uint64_t>(std::random_device{}()) << 32) ^
+                                          std::random_device{}());
+        return seed;
+    }
+
+    /**
+     *  @brief Number of threads that have seeded their generator since the last setRandomSeed
+     */
+    inline std::atomic<uint64_t> &seededThreads()
+    {
+        static std::atomic<uint64_t> count(0);
+        return count;
+    }
+
+    inline randomGenerator &threadRandom()
+    {
+        thread_local randomGenerator generator(librarySeed().load() +
+                                               seededThreads().fetch_add(1) * 0x9e3779b97f4a7c15ULL);
+        return generator;
+    }
+
+    inline void setRandomSeed(uint64_t seed)
+    {
+        librarySeed().store(seed);
+        threadRandom().seed(seed);
+        seededThreads().store(1);
+    }
+
+    /**
+     *  @brief Uniform value in range [0, bound) of an unsigned type
+     *  @param bound bound, 0 stands for 2^w
+     *
+     *  Draws below 2^w mod bound are rejected, so the remaining ones split evenly.
+     *
+     *  @return uniform value
+     */
+    template <typename U>
+    U randomBelowUnsigned(U bound)
+    {
+        randomGenerator &generator = threadRandom();
+        auto draw = [&generator]
+        {
+            U x = static_cast<U>(generator());
+            if constexpr (sizeof(U) > sizeof(uint64_t))
+                x = (x << 64) | static_cast<U>(generator());
+            return x;
+        };
+        if (bound == 0)
+            return draw();
+
+        U threshold = static_cast<U>(-bound) % bound;
+        while (true)
+        {
+            U x = draw();
+            if (x >= threshold)
+                return x % bound;
+        }
+    }
+
+    template <typename T>
+    T randomBelow(const T &bound)
+    {
+        if (bound <= 0)
+        {
+            throw std::invalid_argument("random bound should be positive");
+        }
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            if (bound == 1)
+                return 0;
+            mpz_class top = bound - 1;
+            size_t bits = mpz_sizeinbase(top.get_mpz_t(), 2);
+            std::vector<uint64_t> words((bits + 63) / 64);
+            uint64_t mask = bits % 64 == 0 ? UINT64_MAX : (1ULL << (bits % 64)) - 1;
+            randomGenerator &generator = threadRandom();
+
+            mpz_class result;
+            do
+            {
+                for (uint64_t &word : words)
+                    word = generator();
+                words.back() &= mask;
+                mpz_import(result.get_mpz_t(), words.size(), -1, sizeof(uint64_t), 0, 0, words.data());
+            } while (result >= bound);
+            return result;
+        }
+        else if constexpr (sizeof(T) <= sizeof(uint64_t))
+        {
+            return static_cast<T>(randomBelowUnsigned<uint64_t>(static_cast<uint64_t>(bound)));
+        }
+        else
+        {
+            return static_cast<T>(randomBelowUnsigned<typename wideType<uint64_t>::type>(
+                static_cast<typename wideType<uint64_t>::type>(bound)));
+        }
+    }
+
+    template <typename T>
+    T randomRange(const T &low, const T &high)
+    {
+        if (low > high)
+        {
+            throw std::invalid_argument("random range is empty");
+        }
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            return low + randomBelow<mpz_class>(high - low + 1);
+        }
+        else
+        {
+            using U = typename std::conditional<(sizeof(T) > sizeof(uint64_t)), typename wideType<uint64_t>::type,
+                                                uint64_t>::type;
+            // a full-width range wraps span + 1 to 0, which draws raw bits
+            U span = static_cast<U>(high) - static_cast<U>(low);
+            return static_cast<T>(static_cast<U>(low) + randomBelowUnsigned<U>(span + 1));
+        }
+    }
+
+#endif
+} // namespace modular
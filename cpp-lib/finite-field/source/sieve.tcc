@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../mod-math.h"
+#include "small-primes.tcc"
+
+namespace modular
+{
+#ifndef PRIME_SIEVE
+#define PRIME_SIEVE
+
+    /**
+     *  @brief Integer square root
+     *  @param n value
+     *  @return floor(sqrt(n))
+     */
+    inline uint64_t integerSqrt(uint64_t n)
+    {
+        uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+        while (root > 0 && (root > UINT32_MAX || root * root > n))
+            root--;
+        while (root < UINT32_MAX && (root + 1) * (root + 1) <= n)
+            root++;
+        return root;
+    }
+
+    /**
+     *  @brief Prepares the base primes of the range
+     *
+     *  Odd primes up to storedLimit = min(sqrt(hi - 1), max(2^16, 2 * block)) are found
+     *  with a plain sieve of odd numbers. Since storedLimit^2 >= 2^32 > sqrt(hi), they
+     *  are enough to sieve the remaining base primes segment by segment.
+     */
+    inline primeRange::primeRange(uint64_t _lo, uint64_t _hi, size_t blockBytes)
+        : lo(_lo), hi(_hi), blockSize(blockBytes), blockLow(0), windowLow(0), windowHigh(0), position(0), pendingTwo(false)
+    {
+        if (blockSize == 0)
+        {
+            throw std::invalid_argument("sieve block should not be empty");
+        }
+        // crossing off never steps past 2^64 while hi - 1 + 2p fits
+        if (hi > UINT64_MAX - (1ULL << 33))
+        {
+            throw std::invalid_argument("sieve bound is too large");
+        }
+        if (hi <= lo)
+            hi = lo;
+
+        limit = hi > 1 ? integerSqrt(hi - 1) : 0;
+        storedLimit = std::min<uint64_t>(limit, std::max<uint64_t>(1ULL << 16, 2 * static_cast<uint64_t>(blockSize)));
+        std::vector<uint8_t> small(storedLimit / 2 + 1, 0);
+        for (uint64_t p = 3; p <= storedLimit; p += 2)
+        {
+            if (small[p / 2])
+                continue;
+            basePrimes.push_back(static_cast<uint32_t>(p));
+            for (uint64_t m = p * p; m <= storedLimit; m += 2 * p)
+                small[m / 2] = 1;
+        }
+
+        nextMultiple.resize(basePrimes.size());
+        // tiny blocks share a shorter window instead of keeping thousands of buckets
+        if (limit > storedLimit)
+            buckets.resize(std::clamp<size_t>(largeBaseWindow / blockSize, 1, 256));
+    }
+
+    /**
+     *  @brief Moves back to the start of the range
+     *
+     *  Each base prime p restarts from its first odd multiple not below max(p^2, lo).
+     */
+    inline void primeRange::rewind()
+    {
+        blockLow = std::max<uint64_t>(lo, 3) | 1;
+        position = 0;
+        composite.clear();
+        windowLow = windowHigh = 0;
+        for (std::vector<uint32_t> &bucket : buckets)
+            bucket.clear();
+        pendingTwo = lo <= 2 && 2 < hi;
+        for (size_t i = 0; i < basePrimes.size(); ++i)
+        {
+            uint64_t p = basePrimes[i];
+            uint64_t m = std::max(p * p, (blockLow + p - 1) / p * p);
+            if (m % 2 == 0)
+                m += p;
+            nextMultiple[i] = m;
+        }
+    }
+
+    inline void primeRange::sieveBlock(uint64_t low)
+    {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(blockSize, (hi - low + 1) / 2));
+        composite.assign(count, 0);
+        blockLow = low;
+        position = 0;
+
+        uint64_t high = low + 2 * count;
+        for (size_t i = 0; i < basePrimes.size(); ++i)
+        {
+            uint64_t step = 2 * static_cast<uint64_t>(basePrimes[i]), m = nextMultiple[i];
+            for (; m < high; m += step)
+                composite[(m - low) / 2] = 1;
+            nextMultiple[i] = m;
+        }
+        if (limit > storedLimit)
+        {
+            if (low >= windowHigh)
+                sieveLargeBase(low);
+            std::vector<uint32_t> &bucket = buckets[(low - windowLow) / (2 * blockSize)];
+            for (uint32_t offset : bucket)
+                composite[offset] = 1;
+            bucket.clear();
+        }
+    }
+
+    /**
+     *  @brief Collects the multiples of the base primes in (storedLimit, sqrt(hi - 1)] for a window of blocks
+     *
+     *  These primes are found by sieving odd numbers above storedLimit one segment of
+     *  storedLimit / 2 at a time with the stored primes, once for the whole window of
+     *  buckets.size() blocks. Each of them hits a block at most a few times, so its
+     *  multiples are computed directly and pushed into the bucket of their block.
+     */
+    inline void primeRange::sieveLargeBase(uint64_t low)
+    {
+        windowLow = low;
+        windowHigh = std::min<uint64_t>(hi, low + 2 * static_cast<uint64_t>(blockSize) * buckets.size());
+        uint64_t top = std::min(limit, integerSqrt(windowHigh - 1));
+        // the segments are as long as the stored sieve, independent of a small block size
+        const size_t segmentSize = static_cast<size_t>(storedLimit / 2);
+        baseBlock.resize(segmentSize);
+        for (uint64_t segment = (storedLimit + 1) | 1; segment <= top; segment += 2 * segmentSize)
+        {
+            size_t count = static_cast<size_t>(std::min<uint64_t>(segmentSize, (top - segment) / 2 + 1));
+            std::fill(baseBlock.begin(), baseBlock.begin() + count, 0);
+            uint64_t segmentHigh = segment + 2 * count;
+            for (uint32_t p : basePrimes)
+            {
+                uint64_t q = p, m = std::max(q * q, (segment + q - 1) / q * q);
+                if (m % 2 == 0)
+                    m += q;
+                for (; m < segmentHigh; m += 2 * q)
+                    baseBlock[(m - segment) / 2] = 1;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (baseBlock[i])
+                    continue;
+                uint64_t q = segment + 2 * i, m = std::max(q * q, (low + q - 1) / q * q);
+                if (m % 2 == 0)
+                    m += q;
+                for (; m < windowHigh; m += 2 * q)
+                {
+                    uint64_t index = (m - low) / 2;
+                    buckets[index / blockSize].push_back(static_cast<uint32_t>(index % blockSize));
+                }
+            }
+        }
+    }
+
+    inline bool primeRange::advance(uint64_t &prime)
+    {
+        if (pendingTwo)
+        {
+            pendingTwo = false;
+            prime = 2;
+            return true;
+        }
+        while (true)
+        {
+            while (position < composite.size())
+            {
+                if (!composite[position++])
+                {
+                    prime = blockLow + 2 * (position - 1);
+                    return true;
+                }
+            }
+
+            uint64_t next = blockLow + 2 * composite.size();
+            if (next >= hi)
+                return false;
+            sieveBlock(next);
+        }
+    }
+
+    inline uint64_t primeCount(uint64_t n)
+    {
+        if (n < 2)
+            return 0;
+        uint64_t root = integerSqrt(n);
+
+        // small[v] = S(v) for v <= root, large[i] = S(n / i); S(v) starts as v - 1
+        std::vector<uint64_t> small(root + 1), large(root + 1);
+        for (uint64_t v = 1; v <= root; ++v)
+        {
+            small[v] = v - 1;
+            large[v] = n / v - 1;
+        }
+
+        for (uint64_t p = 2; p <= root; ++p)
+        {
+            if (small[p] == small[p - 1])
+                continue;
+            uint64_t primesBelow = small[p - 1], square = p * p;
+            uint64_t last = std::min(root, n / square);
+            for (uint64_t i = 1; i <= last; ++i)
+            {
+                uint64_t d = i * p;
+                large[i] -= (d <= root ? large[d] : small[n / d]) - primesBelow;
+            }
+            for (uint64_t v = root; v >= square; --v)
+                small[v] -= small[v / p] - primesBelow;
+        }
+        return large[1];
+    }
+
+    template <typename T, typename Visitor>
+    void forEachPrimeFactor(T value, Visitor visit)
+    {
+        value = stripSmallPrimes(value, visit);
+        if (value == 1)
+            return;
+        if (isPrimeValue(value))
+        {
+            visit(value, 1u);
+            return;
+        }
+
+        auto divideOut = [&value, &visit](const T &prime)
+        {
+            unsigned exponent = 0;
+            while (value % prime == 0)
+            {
+                value /= prime;
+                exponent++;
+            }
+            if (exponent > 0)
+                visit(prime, exponent);
+        };
+        if constexpr (std::is_integral<T>::value && sizeof(T) <= sizeof(uint64_t))
+        {
+            primeRange primes(smallPrimeBound, integerSqrt(static_cast<uint64_t>(value)) + 1);
+            for (uint64_t p : primes)
+            {
+                T prime = static_cast<T>(p);
+                if (prime * prime > value)
+                    break;
+                divideOut(prime);
+            }
+        }
+        else
+        {
+            for (T prime = static_cast<T>(smallPrimeBound + 1); prime * prime <= value; prime += 2)
+                divideOut(prime);
+        }
+        if (value > 1)
+            visit(value, 1u);
+    }
+
+#endif
+} // namespace modular
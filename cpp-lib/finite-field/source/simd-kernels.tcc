@@ -0,0 +1,553 @@
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MODULAR_SIMD_X86
+#endif
+
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef SIMD_KERNELS
+#define SIMD_KERNELS
+
+    /**
+     *  @brief Best instruction set supported by the running CPU
+     *  @return detected level, scalar on non-x86 targets
+     */
+    inline simdLevel detectSimdLevel()
+    {
+#ifdef MODULAR_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return simdLevel::avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return simdLevel::avx2;
+#endif
+        return simdLevel::scalar;
+    }
+
+    inline simdLevel &activeSimdLevel()
+    {
+        static simdLevel level = detectSimdLevel();
+        return level;
+    }
+
+    inline simdLevel getSimdLevel()
+    {
+        return activeSimdLevel();
+    }
+
+    inline void setSimdLevel(simdLevel level)
+    {
+        activeSimdLevel() = std::min(level, detectSimdLevel());
+    }
+
+    /**
+     * @brief Montgomery constants of a 32-bit modulus, R = 2^32.
+     */
+    struct montgomery32
+    {
+        uint32_t mod, nPrime, rModN, rSquared;
+    };
+
+    /**
+     *  @brief Precomputes Montgomery constants for an odd modulus below 2^31
+     *  @param mod modulus
+     *  @return constants of the modulus
+     */
+    inline montgomery32 makeMontgomery32(uint32_t mod)
+    {
+        uint32_t inv = 1;
+        for (int i = 0; i < 5; ++i)
+            inv *= 2 - mod * inv;
+        uint64_t r = (static_cast<uint64_t>(1) << 32) % mod;
+        return montgomery32{mod, static_cast<uint32_t>(0 - inv), static_cast<uint32_t>(r),
+                            static_cast<uint32_t>(r * r % mod)};
+    }
+
+    /**
+     *  @brief Checks if 32-bit vector kernels apply to the modulus
+     *  @param mod modulus
+     *  @param needOdd true for kernels that multiply in Montgomery form
+     *  @return true if a vector path can be used
+     */
+    inline bool simd32Applies(uint32_t mod, bool needOdd)
+    {
+        return getSimdLevel() != simdLevel::scalar && mod > 1 && mod < (1u << 31) && (!needOdd || mod % 2 == 1);
+    }
+
+#ifdef MODULAR_SIMD_X86
+
+    __attribute__((target("avx2"))) inline __m256i
+    montMult8(__m256i a, __m256i b, __m256i mod, __m256i nPrime)
+    {
+        __m256i prodEven = _mm256_mul_epu32(a, b);
+        __m256i prodOdd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+        __m256i mEven = _mm256_mul_epu32(prodEven, nPrime);
+        __m256i mOdd = _mm256_mul_epu32(prodOdd, nPrime);
+
+        __m256i uEven = _mm256_srli_epi64(_mm256_add_epi64(prodEven, _mm256_mul_epu32(mEven, mod)), 32);
+        __m256i uOdd = _mm256_add_epi64(prodOdd, _mm256_mul_epu32(mOdd, mod));
+
+        __m256i u = _mm256_blend_epi32(uEven, uOdd, 0xAA);
+        return _mm256_min_epu32(u, _mm256_sub_epi32(u, mod));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    addMod8(__m256i a, __m256i b, __m256i mod)
+    {
+        __m256i sum = _mm256_add_epi32(a, b);
+        return _mm256_min_epu32(sum, _mm256_sub_epi32(sum, mod));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i
+    subsMod8(__m256i a, __m256i b, __m256i mod)
+    {
+        __m256i diff = _mm256_sub_epi32(a, b);
+        return _mm256_min_epu32(diff, _mm256_add_epi32(diff, mod));
+    }
+
+    // GCC 12 reports the self-initialized __Y of _mm512_undefined_epi32, used by the
+    // AVX-512 intrinsics below, as maybe uninitialized once they are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+    __attribute__((target("avx512f"))) inline __m512i
+    montMult16(__m512i a, __m512i b, __m512i mod, __m512i nPrime)
+    {
+        __m512i prodEven = _mm512_mul_epu32(a, b);
+        __m512i prodOdd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+
+        __m512i mEven = _mm512_mul_epu32(prodEven, nPrime);
+        __m512i mOdd = _mm512_mul_epu32(prodOdd, nPrime);
+
+        __m512i uEven = _mm512_srli_epi64(_mm512_add_epi64(prodEven, _mm512_mul_epu32(mEven, mod)), 32);
+        __m512i uOdd = _mm512_add_epi64(prodOdd, _mm512_mul_epu32(mOdd, mod));
+
+        __m512i u = _mm512_mask_blend_epi32(0xAAAA, uEven, uOdd);
+        return _mm512_min_epu32(u, _mm512_sub_epi32(u, mod));
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i
+    addMod16(__m512i a, __m512i b, __m512i mod)
+    {
+        __m512i sum = _mm512_add_epi32(a, b);
+        return _mm512_min_epu32(sum, _mm512_sub_epi32(sum, mod));
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i
+    subsMod16(__m512i a, __m512i b, __m512i mod)
+    {
+        __m512i diff = _mm512_sub_epi32(a, b);
+        return _mm512_min_epu32(diff, _mm512_add_epi32(diff, mod));
+    }
+
+    // Every kernel below handles [0, size - size % width) and returns the number of processed elements,
+    // the scalar loop of the public function finishes the tail.
+
+    __attribute__((target("avx2"))) inline size_t
+    bulkAddAvx2(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod)
+    {
+        const __m256i m = _mm256_set1_epi32(mod);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), addMod8(x, y, m));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t
+    bulkAddAvx512(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod)
+    {
+        const __m512i m = _mm512_set1_epi32(mod);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m512i x = _mm512_loadu_si512(a + i), y = _mm512_loadu_si512(b + i);
+            _mm512_storeu_si512(result + i, addMod16(x, y, m));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) inline size_t
+    bulkSubsAvx2(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod)
+    {
+        const __m256i m = _mm256_set1_epi32(mod);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), subsMod8(x, y, m));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t
+    bulkSubsAvx512(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod)
+    {
+        const __m512i m = _mm512_set1_epi32(mod);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m512i x = _mm512_loadu_si512(a + i), y = _mm512_loadu_si512(b + i);
+            _mm512_storeu_si512(result + i, subsMod16(x, y, m));
+        }
+        return i;
+    }
+
+    /**
+     *  @brief result = a * b + c, c may be null
+     *
+     *  a * b * R^-1 is brought back to the usual form by one more Montgomery
+     *  product with R^2, so the inputs are not converted.
+     */
+    __attribute__((target("avx2"))) inline size_t
+    bulkMultAddAvx2(uint32_t *result, const uint32_t *a, const uint32_t *b, const uint32_t *c, size_t size,
+                    const montgomery32 &ctx)
+    {
+        const __m256i m = _mm256_set1_epi32(ctx.mod), nPrime = _mm256_set1_epi32(ctx.nPrime);
+        const __m256i r2 = _mm256_set1_epi32(ctx.rSquared);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            __m256i prod = montMult8(montMult8(x, y, m, nPrime), r2, m, nPrime);
+            if (c != nullptr)
+                prod = addMod8(prod, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c + i)), m);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), prod);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t
+    bulkMultAddAvx512(uint32_t *result, const uint32_t *a, const uint32_t *b, const uint32_t *c, size_t size,
+                      const montgomery32 &ctx)
+    {
+        const __m512i m = _mm512_set1_epi32(ctx.mod), nPrime = _mm512_set1_epi32(ctx.nPrime);
+        const __m512i r2 = _mm512_set1_epi32(ctx.rSquared);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m512i x = _mm512_loadu_si512(a + i), y = _mm512_loadu_si512(b + i);
+            __m512i prod = montMult16(montMult16(x, y, m, nPrime), r2, m, nPrime);
+            if (c != nullptr)
+                prod = addMod16(prod, _mm512_loadu_si512(c + i), m);
+            _mm512_storeu_si512(result + i, prod);
+        }
+        return i;
+    }
+
+    /**
+     *  @brief result = a * scalar, the scalar is passed in Montgomery form
+     */
+    __attribute__((target("avx2"))) inline size_t
+    bulkScaleAvx2(uint32_t *result, const uint32_t *a, uint32_t scalarMont, size_t size, const montgomery32 &ctx)
+    {
+        const __m256i m = _mm256_set1_epi32(ctx.mod), nPrime = _mm256_set1_epi32(ctx.nPrime);
+        const __m256i s = _mm256_set1_epi32(scalarMont);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), montMult8(x, s, m, nPrime));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t
+    bulkScaleAvx512(uint32_t *result, const uint32_t *a, uint32_t scalarMont, size_t size, const montgomery32 &ctx)
+    {
+        const __m512i m = _mm512_set1_epi32(ctx.mod), nPrime = _mm512_set1_epi32(ctx.nPrime);
+        const __m512i s = _mm512_set1_epi32(scalarMont);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m512i x = _mm512_loadu_si512(a + i);
+            _mm512_storeu_si512(result + i, montMult16(x, s, m, nPrime));
+        }
+        return i;
+    }
+
+    /**
+     *  @brief Lane-wise sums of a[i] * b[i] * R^-1, reduced to one residue
+     */
+    __attribute__((target("avx2"))) inline size_t
+    bulkDotAvx2(const uint32_t *a, const uint32_t *b, size_t size, const montgomery32 &ctx, uint32_t &sum)
+    {
+        const __m256i m = _mm256_set1_epi32(ctx.mod), nPrime = _mm256_set1_epi32(ctx.nPrime);
+        __m256i acc = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            acc = addMod8(acc, montMult8(x, y, m, nPrime), m);
+        }
+        alignas(32) uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+        uint64_t total = 0;
+        for (uint32_t lane : lanes)
+            total += lane;
+        sum = static_cast<uint32_t>(total % ctx.mod);
+        return i;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t
+    bulkDotAvx512(const uint32_t *a, const uint32_t *b, size_t size, const montgomery32 &ctx, uint32_t &sum)
+    {
+        const __m512i m = _mm512_set1_epi32(ctx.mod), nPrime = _mm512_set1_epi32(ctx.nPrime);
+        __m512i acc = _mm512_setzero_si512();
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m512i x = _mm512_loadu_si512(a + i), y = _mm512_loadu_si512(b + i);
+            acc = addMod16(acc, montMult16(x, y, m, nPrime), m);
+        }
+        alignas(64) uint32_t lanes[16];
+        _mm512_store_si512(lanes, acc);
+        uint64_t total = 0;
+        for (uint32_t lane : lanes)
+            total += lane;
+        sum = static_cast<uint32_t>(total % ctx.mod);
+        return i;
+    }
+
+    __attribute__((target("avx2"))) inline size_t
+    bulkAddAvx2(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod)
+    {
+        const __m256i m = _mm256_set1_epi64x(static_cast<long long>(mod));
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            __m256i sum = _mm256_add_epi64(x, y);
+            // mod < 2^62, so the signed comparison is exact
+            __m256i below = _mm256_cmpgt_epi64(m, sum);
+            __m256i res = _mm256_sub_epi64(sum, _mm256_andnot_si256(below, m));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), res);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t
+    bulkAddAvx512(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod)
+    {
+        const __m512i m = _mm512_set1_epi64(static_cast<long long>(mod));
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            __m512i sum = _mm512_add_epi64(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+            _mm512_storeu_si512(result + i, _mm512_min_epu64(sum, _mm512_sub_epi64(sum, m)));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) inline size_t
+    bulkSubsAvx2(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod)
+    {
+        const __m256i m = _mm256_set1_epi64x(static_cast<long long>(mod));
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            __m256i borrow = _mm256_cmpgt_epi64(y, x);
+            __m256i res = _mm256_add_epi64(_mm256_sub_epi64(x, y), _mm256_and_si256(borrow, m));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), res);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t
+    bulkSubsAvx512(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod)
+    {
+        const __m512i m = _mm512_set1_epi64(static_cast<long long>(mod));
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            __m512i diff = _mm512_sub_epi64(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+            _mm512_storeu_si512(result + i, _mm512_min_epu64(diff, _mm512_add_epi64(diff, m)));
+        }
+        return i;
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+    /**
+     *  @brief Checks if 64-bit vector add/subs apply to the modulus
+     *  @param mod modulus
+     *  @return true if the sums and differences fit the vector comparisons
+     */
+    inline bool simd64Applies(uint64_t mod)
+    {
+        simdLevel level = getSimdLevel();
+        if (level == simdLevel::avx512)
+            return mod > 1 && mod < (static_cast<uint64_t>(1) << 63);
+        return level == simdLevel::avx2 && mod > 1 && mod < (static_cast<uint64_t>(1) << 62);
+    }
+
+    inline void bulkAdd(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod)
+    {
+        size_t i = 0;
+#ifdef MODULAR_SIMD_X86
+        if (simd32Applies(mod, false))
+            i = getSimdLevel() == simdLevel::avx512 ? bulkAddAvx512(result, a, b, size, mod)
+                                                    : bulkAddAvx2(result, a, b, size, mod);
+#endif
+        for (; i < size; ++i)
+        {
+            uint64_t sum = static_cast<uint64_t>(a[i]) + b[i];
+            result[i] = static_cast<uint32_t>(sum >= mod ? sum - mod : sum);
+        }
+    }
+
+    inline void bulkSubs(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod)
+    {
+        size_t i = 0;
+#ifdef MODULAR_SIMD_X86
+        if (simd32Applies(mod, false))
+            i = getSimdLevel() == simdLevel::avx512 ? bulkSubsAvx512(result, a, b, size, mod)
+                                                    : bulkSubsAvx2(result, a, b, size, mod);
+#endif
+        for (; i < size; ++i)
+            result[i] = a[i] >= b[i] ? a[i] - b[i] : a[i] + (mod - b[i]);
+    }
+
+    inline void bulkMultAdd(uint32_t *result, const uint32_t *a, const uint32_t *b, const uint32_t *c, size_t size,
+                            uint32_t mod)
+    {
+        size_t i = 0;
+#ifdef MODULAR_SIMD_X86
+        if (simd32Applies(mod, true))
+        {
+            montgomery32 ctx = makeMontgomery32(mod);
+            i = getSimdLevel() == simdLevel::avx512 ? bulkMultAddAvx512(result, a, b, c, size, ctx)
+                                                    : bulkMultAddAvx2(result, a, b, c, size, ctx);
+        }
+#endif
+        for (; i < size; ++i)
+        {
+            uint64_t prod = static_cast<uint64_t>(a[i]) * b[i] + (c != nullptr ? c[i] : 0);
+            result[i] = static_cast<uint32_t>(prod % mod);
+        }
+    }
+
+    inline void bulkMult(uint32_t *result, const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod)
+    {
+        bulkMultAdd(result, a, b, nullptr, size, mod);
+    }
+
+    inline void bulkScale(uint32_t *result, const uint32_t *a, uint32_t scalar, size_t size, uint32_t mod)
+    {
+        size_t i = 0;
+        scalar %= mod;
+#ifdef MODULAR_SIMD_X86
+        if (simd32Applies(mod, true))
+        {
+            montgomery32 ctx = makeMontgomery32(mod);
+            uint32_t scalarMont = static_cast<uint32_t>((static_cast<uint64_t>(scalar) << 32) % mod);
+            i = getSimdLevel() == simdLevel::avx512 ? bulkScaleAvx512(result, a, scalarMont, size, ctx)
+                                                    : bulkScaleAvx2(result, a, scalarMont, size, ctx);
+        }
+#endif
+        for (; i < size; ++i)
+            result[i] = static_cast<uint32_t>(static_cast<uint64_t>(a[i]) * scalar % mod);
+    }
+
+    inline uint32_t bulkDot(const uint32_t *a, const uint32_t *b, size_t size, uint32_t mod)
+    {
+        size_t i = 0;
+        uint64_t sum = 0;
+#ifdef MODULAR_SIMD_X86
+        if (simd32Applies(mod, true))
+        {
+            montgomery32 ctx = makeMontgomery32(mod);
+            uint32_t vectorSum = 0;
+            i = getSimdLevel() == simdLevel::avx512 ? bulkDotAvx512(a, b, size, ctx, vectorSum)
+                                                    : bulkDotAvx2(a, b, size, ctx, vectorSum);
+            // the lanes hold products times R^-1
+            sum = static_cast<uint64_t>(vectorSum) * ctx.rModN % mod;
+        }
+#endif
+        for (; i < size; ++i)
+            sum = (sum + static_cast<uint64_t>(a[i]) * b[i]) % mod;
+        return static_cast<uint32_t>(sum % mod);
+    }
+
+    inline void bulkAdd(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod)
+    {
+        size_t i = 0;
+#ifdef MODULAR_SIMD_X86
+        if (simd64Applies(mod))
+            i = getSimdLevel() == simdLevel::avx512 ? bulkAddAvx512(result, a, b, size, mod)
+                                                    : bulkAddAvx2(result, a, b, size, mod);
+#endif
+        for (; i < size; ++i)
+            result[i] = a[i] >= mod - b[i] ? a[i] - (mod - b[i]) : a[i] + b[i];
+    }
+
+    inline void bulkSubs(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod)
+    {
+        size_t i = 0;
+#ifdef MODULAR_SIMD_X86
+        if (simd64Applies(mod))
+            i = getSimdLevel() == simdLevel::avx512 ? bulkSubsAvx512(result, a, b, size, mod)
+                                                    : bulkSubsAvx2(result, a, b, size, mod);
+#endif
+        for (; i < size; ++i)
+            result[i] = a[i] >= b[i] ? a[i] - b[i] : a[i] + (mod - b[i]);
+    }
+
+    inline void bulkMultAdd(uint64_t *result, const uint64_t *a, const uint64_t *b, const uint64_t *c, size_t size,
+                            uint64_t mod)
+    {
+        BarrettReducer reducer(mod);
+        for (size_t i = 0; i < size; ++i)
+        {
+            unsigned __int128 prod = static_cast<unsigned __int128>(a[i]) * b[i];
+            if (c != nullptr)
+                prod += c[i];
+            result[i] = reducer.reduce(prod);
+        }
+    }
+
+    inline void bulkMult(uint64_t *result, const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod)
+    {
+        bulkMultAdd(result, a, b, nullptr, size, mod);
+    }
+
+    inline void bulkScale(uint64_t *result, const uint64_t *a, uint64_t scalar, size_t size, uint64_t mod)
+    {
+        BarrettReducer reducer(mod);
+        scalar %= mod;
+        for (size_t i = 0; i < size; ++i)
+            result[i] = reducer.mult(a[i], scalar);
+    }
+
+    inline uint64_t bulkDot(const uint64_t *a, const uint64_t *b, size_t size, uint64_t mod)
+    {
+        BarrettReducer reducer(mod);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < size; ++i)
+            sum = reducer.reduce(static_cast<unsigned __int128>(a[i]) * b[i] + sum);
+        return sum;
+    }
+
+#endif
+} // namespace modular
@@ -0,0 +1,812 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "../mod-math.h"
+#include "factorization.tcc"
+#include "gcd.tcc"
+#include "parallel.tcc"
+#include "pollard-williams.tcc"
+#include "random.tcc"
+#include "sieve.tcc"
+#include "sqrt.tcc"
+
+namespace modular
+{
+#ifndef SIQS_FACTOR
+#define SIQS_FACTOR
+
+    /**
+     *  @brief Sieve parameters for one size of composite
+     */
+    struct siqsParameters
+    {
+        size_t digits;
+        size_t primes;      // size of the factor base
+        uint32_t halfWidth; // the sieve interval is [-halfWidth, halfWidth)
+    };
+
+    /**
+     *  @brief Bytes of the sieve array processed at once, sized for the L1 data cache
+     */
+    inline constexpr uint32_t siqsBlockSize = 32768;
+
+    /**
+     *  @brief Largest composite, in decimal digits, covered by the parameter table; larger ones use its last row
+     */
+    inline constexpr size_t siqsMaxDigits = 100;
+
+    /**
+     *  @brief Interpolates the factor base size and the sieve interval for a composite
+     *  @param digits decimal digits of the composite
+     *  @return parameters, with the half width rounded up to whole blocks
+     */
+    inline siqsParameters siqsChooseParameters(size_t digits)
+    {
+        static const siqsParameters table[] = {
+            {20, 100, 32768}, {30, 200, 32768}, {40, 450, 32768}, {50, 1100, 65536}, {60, 2300, 98304}, {70, 4700, 131072},
+            {80, 9000, 163840}, {90, 17000, 229376}, {100, 30000, 294912},
+        };
+        const size_t count = sizeof(table) / sizeof(table[0]);
+        if (digits <= table[0].digits)
+            return table[0];
+        if (digits >= table[count - 1].digits)
+            return table[count - 1];
+
+        size_t i = 1;
+        while (table[i].digits < digits)
+            ++i;
+        const siqsParameters &lo = table[i - 1], &hi = table[i];
+        double t = static_cast<double>(digits - lo.digits) / static_cast<double>(hi.digits - lo.digits);
+
+        siqsParameters result;
+        result.digits = digits;
+        result.primes = lo.primes + static_cast<size_t>(t * static_cast<double>(hi.primes - lo.primes));
+        uint32_t width = lo.halfWidth + static_cast<uint32_t>(t * static_cast<double>(hi.halfWidth - lo.halfWidth));
+        result.halfWidth = (width + siqsBlockSize - 1) / siqsBlockSize * siqsBlockSize;
+        return result;
+    }
+
+    /**
+     *  @brief Chooses the Knuth-Schroeppel multiplier
+     *  @param n odd composite
+     *
+     *  Every odd square-free k below 75 is scored by the expected contribution of the
+     *  small primes to the sieve values of kn, minus half of log k for the larger values.
+     *
+     *  @return multiplier k
+     */
+    inline unsigned siqsMultiplier(const mpz_class &n)
+    {
+        static const unsigned candidates[] = {1,  3,  5,  7,  11, 13, 15, 17, 19, 21, 23, 29, 31, 33, 35, 37,
+                                              39, 41, 43, 47, 51, 53, 55, 57, 59, 61, 65, 67, 69, 71, 73};
+        std::vector<long long> residues;
+        residues.reserve(smallPrimeTable.size());
+        for (const smallPrime &entry : smallPrimeTable)
+            residues.push_back(static_cast<long long>(mpz_fdiv_ui(n.get_mpz_t(), entry.prime)));
+        unsigned nMod8 = static_cast<unsigned>(mpz_fdiv_ui(n.get_mpz_t(), 8));
+
+        unsigned best = 1;
+        double bestScore = 0;
+        for (unsigned k : candidates)
+        {
+            double score = -0.5 * std::log(static_cast<double>(k));
+            switch (nMod8 * k % 8)
+            {
+            case 1:
+                score += 2 * std::log(2.0);
+                break;
+            case 5:
+                score += std::log(2.0);
+                break;
+            default:
+                score += 0.5 * std::log(2.0);
+            }
+            for (size_t i = 1; i < smallPrimeTable.size(); ++i)
+            {
+                long long p = smallPrimeTable[i].prime;
+                double contribution = std::log(static_cast<double>(p)) / static_cast<double>(p - 1);
+                if (k % p == 0)
+                    score += contribution;
+                else if (legendreSymbol<long long>(residues[i] * k % p, p) == 1)
+                    score += 2 * contribution;
+            }
+            if (k == 1 || score > bestScore)
+            {
+                best = k;
+                bestScore = score;
+            }
+        }
+        return best;
+    }
+
+    /**
+     *  @brief Self-initializing quadratic sieve for one composite
+     *
+     *  Polynomials g(x) = ((A x + B)^2 - kn) / A with A a product of s factor base primes
+     *  are sieved over [-M, M) in cache-sized blocks. The 2^(s - 1) values of B that belong
+     *  to one A are visited in Gray code order, so switching polynomials costs one addition
+     *  per prime. Workers draw their own A and sieve independently; relations are merged
+     *  under a lock, and values with one prime above the factor base are kept until a
+     *  second value with the same large prime turns up.
+     */
+    class quadraticSieve
+    {
+    private:
+        struct basePrime
+        {
+            uint32_t prime, root, halfWidthMod;
+            uint8_t logp;
+        };
+
+        /**
+         *  y^2 = (-1)^e0 * product of the factor base primes of the columns * square^2 (mod n).
+         *  Column 0 is the sign, column i + 1 is base[i].
+         */
+        struct relation
+        {
+            mpz_class y;
+            std::vector<uint32_t> columns;
+            mpz_class square;
+        };
+
+        const mpz_class &n;
+        mpz_class kn, targetA, divisor = 1;
+        size_t threads;
+        siqsParameters params;
+        std::vector<basePrime> base;
+        std::vector<size_t> pool;
+        size_t firstSieved = 0, aFactors = 2, wanted = 0, partialLimit = 0;
+        uint8_t threshold = 0;
+        uint64_t largeBound = 0;
+
+        std::mutex lock;
+        std::atomic<bool> enough{false};
+        std::vector<relation> full;
+        std::unordered_map<uint64_t, relation> partial;
+        std::set<mpz_class> usedA;
+
+        /**
+         *  @brief Per-worker state of one polynomial family
+         */
+        struct family
+        {
+            mpz_class a, b;
+            std::vector<size_t> q;
+            std::vector<mpz_class> bl;
+            std::vector<uint32_t> root1, root2, start1, start2, next1, next2, bainv2;
+            std::vector<char> inA;
+            std::vector<uint8_t> sieve;
+            std::vector<relation> fulls;
+            std::vector<std::pair<uint64_t, relation>> partials;
+        };
+
+        bool buildBase();
+        void drawA(family &f);
+        void initFamily(family &f);
+        void nextB(family &f, size_t index);
+        void sieveFamily(family &f);
+        void checkCandidate(family &f, uint32_t index);
+        void submit(family &f);
+        mpz_class solve();
+
+    public:
+        quadraticSieve(const mpz_class &_n, size_t _threads);
+        mpz_class run();
+    };
+
+    /**
+     *  @brief Prepares the factor base, the sieve threshold and the pool of A factors
+     *  @param _n odd composite that is not a perfect power
+     *  @param _threads number of workers, 0 for one per hardware thread
+     */
+    inline quadraticSieve::quadraticSieve(const mpz_class &_n, size_t _threads) : n(_n), threads(_threads)
+    {
+        unsigned k = siqsMultiplier(n);
+        kn = n * k;
+        params = siqsChooseParameters(mpz_sizeinbase(n.get_mpz_t(), 10));
+        if (!buildBase())
+            return;
+
+        // |g(x)| stays below M sqrt(kn / 2) on the interval
+        double logValue = std::log2(static_cast<double>(params.halfWidth)) +
+                          0.5 * (static_cast<double>(mpz_sizeinbase(kn.get_mpz_t(), 2)) - 1);
+        // primes below 30 are not sieved, their expected share is taken off the threshold
+        double skipped = 0;
+        while (firstSieved < base.size() && base[firstSieved].prime < 30)
+        {
+            double p = base[firstSieved].prime;
+            skipped += (base[firstSieved].root == 0 ? 1 : 2) * std::log2(p) / (p - 1);
+            ++firstSieved;
+        }
+        uint64_t pmax = base.back().prime;
+        largeBound = pmax * 64;
+        double level = logValue - std::log2(static_cast<double>(largeBound)) - skipped;
+        threshold = static_cast<uint8_t>(std::clamp(level, 8.0, 250.0));
+
+        wanted = base.size() + 1 + 48;
+        partialLimit = std::max<size_t>(10000, 10 * base.size());
+
+        // A is close to sqrt(2 kn) / M, a product of primes of about 11 bits when the base allows
+        mpz_class twice = 2 * kn;
+        mpz_sqrt(targetA.get_mpz_t(), twice.get_mpz_t());
+        targetA /= params.halfWidth;
+        double logTarget = static_cast<double>(mpz_sizeinbase(targetA.get_mpz_t(), 2));
+        double qBits = std::min(11.0, std::log2(static_cast<double>(pmax)) - 1);
+        aFactors = std::clamp<size_t>(static_cast<size_t>(std::lround(logTarget / qBits)), 2, 20);
+        double ideal = logTarget / static_cast<double>(aFactors);
+        for (double spread = 0.5; pool.size() < 2 * aFactors + 4 && spread < 64; spread += 0.5)
+        {
+            pool.clear();
+            for (size_t i = firstSieved; i < base.size(); ++i)
+                if (base[i].root != 0 && std::abs(std::log2(static_cast<double>(base[i].prime)) - ideal) <= spread)
+                    pool.push_back(i);
+        }
+    }
+
+    /**
+     *  @brief Collects the primes p with (kn / p) != -1 and the square roots of kn modulo them
+     *  @return false if a prime of the base divides n, the prime is kept as the divisor
+     */
+    inline bool quadraticSieve::buildBase()
+    {
+        uint64_t hi = 40 * static_cast<uint64_t>(params.primes) + 1000;
+        primeRange primes(2, hi);
+        for (uint64_t p : primes)
+        {
+            if (base.size() == params.primes)
+                break;
+            long long residue = static_cast<long long>(mpz_fdiv_ui(kn.get_mpz_t(), p));
+            basePrime entry;
+            entry.prime = static_cast<uint32_t>(p);
+            entry.halfWidthMod = params.halfWidth % entry.prime;
+            entry.logp = static_cast<uint8_t>(std::lround(std::log2(static_cast<double>(p))));
+            if (p == 2)
+                entry.root = static_cast<uint32_t>(residue);
+            else if (residue == 0)
+            {
+                if (mpz_divisible_ui_p(n.get_mpz_t(), p))
+                {
+                    divisor = static_cast<unsigned long>(p);
+                    return false;
+                }
+                entry.root = 0;
+            }
+            else if (legendreSymbol<long long>(residue, static_cast<long long>(p)) == 1)
+            {
+                std::vector<long long> roots = sqrtPrime(modNum<long long>(residue, static_cast<long long>(p)));
+                entry.root = static_cast<uint32_t>(roots[0]);
+            }
+            else
+                continue;
+            base.push_back(entry);
+        }
+        return true;
+    }
+
+    /**
+     *  @brief Picks the primes of a new A
+     *
+     *  All but the last prime are drawn from the pool; the last one is the base prime
+     *  closest to the remaining quotient, so A lands near its target.
+     */
+    inline void quadraticSieve::drawA(family &f)
+    {
+        for (size_t attempt = 0;; ++attempt)
+        {
+            f.q.clear();
+            f.a = 1;
+            while (f.q.size() + 1 < aFactors)
+            {
+                size_t i = pool[randomBelow<size_t>(pool.size())];
+                if (std::find(f.q.begin(), f.q.end(), i) != f.q.end())
+                    continue;
+                f.q.push_back(i);
+                f.a *= base[i].prime;
+            }
+
+            mpz_class rest = targetA / f.a;
+            uint64_t want = rest.fits_ulong_p() ? rest.get_ui() : UINT64_MAX;
+            size_t last = base.size();
+            uint64_t distance = UINT64_MAX;
+            for (size_t i = firstSieved; i < base.size(); ++i)
+            {
+                if (base[i].root == 0 || std::find(f.q.begin(), f.q.end(), i) != f.q.end())
+                    continue;
+                uint64_t p = base[i].prime, gap = p > want ? p - want : want - p;
+                if (gap < distance)
+                {
+                    last = i;
+                    distance = gap;
+                }
+            }
+            f.q.push_back(last);
+            f.a *= base[last].prime;
+
+            std::lock_guard<std::mutex> guard(lock);
+            if (usedA.insert(f.a).second || attempt >= 64)
+                return;
+        }
+    }
+
+    /**
+     *  @brief Computes the B_l of the current A and the roots of the first polynomial
+     *
+     *  B_l = (A / q_l) * (t_l * (A / q_l)^-1 mod q_l) with t_l^2 = kn (mod q_l), so every
+     *  sum of the +-B_l squares to kn modulo A. The roots of g are (+-t - B) / A modulo p.
+     */
+    inline void quadraticSieve::initFamily(family &f)
+    {
+        size_t size = base.size(), s = f.q.size();
+        f.bl.assign(s, 0);
+        f.b = 0;
+        for (size_t l = 0; l < s; ++l)
+        {
+            const basePrime &entry = base[f.q[l]];
+            mpz_class cofactor = f.a / entry.prime;
+            uint64_t inverse = modInverse<uint64_t>(mpz_fdiv_ui(cofactor.get_mpz_t(), entry.prime), entry.prime);
+            uint64_t gamma = static_cast<uint64_t>(entry.root) * inverse % entry.prime;
+            if (gamma > entry.prime / 2)
+                gamma = entry.prime - gamma;
+            f.bl[l] = cofactor * static_cast<unsigned long>(gamma);
+            f.b += f.bl[l];
+        }
+
+        f.inA.assign(size, 0);
+        for (size_t i : f.q)
+            f.inA[i] = 1;
+        f.root1.assign(size, 0);
+        f.root2.assign(size, 0);
+        f.bainv2.assign(s * size, 0);
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (f.inA[i])
+                continue;
+            uint64_t p = base[i].prime;
+            uint64_t ainv = modInverse<uint64_t>(mpz_fdiv_ui(f.a.get_mpz_t(), p), p);
+            for (size_t l = 0; l < s; ++l)
+                f.bainv2[l * size + i] =
+                    static_cast<uint32_t>(2 * mpz_fdiv_ui(f.bl[l].get_mpz_t(), p) % p * ainv % p);
+            uint64_t bModP = mpz_fdiv_ui(f.b.get_mpz_t(), p), t = base[i].root;
+            f.root1[i] = static_cast<uint32_t>(ainv * ((t + p - bModP) % p) % p);
+            f.root2[i] = static_cast<uint32_t>(ainv * ((2 * p - t - bModP) % p) % p);
+        }
+    }
+
+    /**
+     *  @brief Moves to polynomial number index of the family in Gray code order
+     *
+     *  Bit v of the Gray code flips, B changes by -+2 B_v and every root moves by +-2 B_v / A.
+     */
+    inline void quadraticSieve::nextB(family &f, size_t index)
+    {
+        size_t v = 0;
+        while (((index >> v) & 1) == 0)
+            ++v;
+        bool negate = (((index ^ (index >> 1)) >> v) & 1) != 0;
+        if (negate)
+            f.b -= 2 * f.bl[v];
+        else
+            f.b += 2 * f.bl[v];
+
+        size_t size = base.size();
+        const uint32_t *delta = f.bainv2.data() + v * size;
+        for (size_t i = 0; i < size; ++i)
+        {
+            uint32_t p = base[i].prime, d = delta[i];
+            if (negate)
+            {
+                // roots of the new polynomial are r + 2 B_v / A
+                f.root1[i] = f.root1[i] + d >= p ? f.root1[i] + d - p : f.root1[i] + d;
+                f.root2[i] = f.root2[i] + d >= p ? f.root2[i] + d - p : f.root2[i] + d;
+            }
+            else
+            {
+                f.root1[i] = f.root1[i] >= d ? f.root1[i] - d : f.root1[i] + p - d;
+                f.root2[i] = f.root2[i] >= d ? f.root2[i] - d : f.root2[i] + p - d;
+            }
+        }
+    }
+
+    /**
+     *  @brief Sieves every polynomial of the current family block by block
+     *
+     *  Each prime keeps the offset of its next hit, so a block is finished before the
+     *  next one is touched. Values are scanned eight bytes at a time for the top bit.
+     */
+    inline void quadraticSieve::sieveFamily(family &f)
+    {
+        size_t size = base.size(), polynomials = static_cast<size_t>(1) << (f.q.size() - 1);
+        uint32_t width = 2 * params.halfWidth;
+        unsigned hitLevel = std::max<unsigned>(threshold, 128);
+        uint8_t init = threshold < 128 ? static_cast<uint8_t>(128 - threshold) : 0;
+        f.start1.resize(size);
+        f.start2.resize(size);
+        f.next1.resize(size);
+        f.next2.resize(size);
+        f.sieve.resize(siqsBlockSize);
+
+        for (size_t index = 0; index < polynomials && !enough.load(); ++index)
+        {
+            if (index > 0)
+                nextB(f, index);
+            for (size_t i = 0; i < size; ++i)
+            {
+                uint32_t p = base[i].prime, shift = base[i].halfWidthMod;
+                f.start1[i] = f.next1[i] = f.root1[i] + shift >= p ? f.root1[i] + shift - p : f.root1[i] + shift;
+                f.start2[i] = f.next2[i] = f.root2[i] + shift >= p ? f.root2[i] + shift - p : f.root2[i] + shift;
+            }
+
+            for (uint32_t blockLow = 0; blockLow < width; blockLow += siqsBlockSize)
+            {
+                uint8_t *sieve = f.sieve.data();
+                std::fill(sieve, sieve + siqsBlockSize, init);
+                for (size_t i = firstSieved; i < size; ++i)
+                {
+                    if (f.inA[i])
+                        continue;
+                    uint32_t p = base[i].prime;
+                    uint8_t logp = base[i].logp;
+                    uint32_t position = f.next1[i];
+                    for (; position < siqsBlockSize; position += p)
+                        sieve[position] += logp;
+                    f.next1[i] = position - siqsBlockSize;
+                    if (f.root2[i] == f.root1[i])
+                        continue;
+                    position = f.next2[i];
+                    for (; position < siqsBlockSize; position += p)
+                        sieve[position] += logp;
+                    f.next2[i] = position - siqsBlockSize;
+                }
+
+                for (uint32_t j = 0; j < siqsBlockSize; j += 8)
+                {
+                    uint64_t word;
+                    std::memcpy(&word, sieve + j, sizeof(word));
+                    if ((word & 0x8080808080808080ULL) == 0)
+                        continue;
+                    for (uint32_t m = j; m < j + 8; ++m)
+                        if (sieve[m] >= hitLevel)
+                            checkCandidate(f, blockLow + m);
+                }
+            }
+            submit(f);
+        }
+    }
+
+    /**
+     *  @brief Trial divides g(x) at a sieve hit by the primes whose roots match the position
+     *  @param index position in the interval, x = index - M
+     */
+    inline void quadraticSieve::checkCandidate(family &f, uint32_t index)
+    {
+        long x = static_cast<long>(index) - static_cast<long>(params.halfWidth);
+        relation r;
+        r.y = f.a * x + f.b;
+        mpz_class value = r.y * r.y - kn;
+        mpz_divexact(value.get_mpz_t(), value.get_mpz_t(), f.a.get_mpz_t());
+        if (value < 0)
+        {
+            r.columns.push_back(0);
+            value = -value;
+        }
+        for (size_t i : f.q)
+            r.columns.push_back(static_cast<uint32_t>(i + 1));
+
+        for (size_t i = 0; i < base.size(); ++i)
+        {
+            uint32_t p = base[i].prime;
+            if (!f.inA[i])
+            {
+                uint32_t offset = index % p;
+                if (offset != f.start1[i] && offset != f.start2[i])
+                    continue;
+            }
+            while (mpz_divisible_ui_p(value.get_mpz_t(), p))
+            {
+                mpz_divexact_ui(value.get_mpz_t(), value.get_mpz_t(), p);
+                r.columns.push_back(static_cast<uint32_t>(i + 1));
+            }
+        }
+
+        r.y %= n;
+        r.square = 1;
+        if (value == 1)
+            f.fulls.push_back(std::move(r));
+        else if (value.fits_ulong_p() && value.get_ui() < largeBound)
+            f.partials.emplace_back(value.get_ui(), std::move(r));
+    }
+
+    /**
+     *  @brief Hands the relations of a worker to the shared store
+     *
+     *  A partial relation whose large prime is already stored is multiplied with the
+     *  stored one; the product is a full relation with the large prime squared.
+     */
+    inline void quadraticSieve::submit(family &f)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        for (relation &r : f.fulls)
+            full.push_back(std::move(r));
+        for (auto &[large, r] : f.partials)
+        {
+            auto it = partial.find(large);
+            if (it == partial.end())
+            {
+                if (partial.size() < partialLimit)
+                    partial.emplace(large, std::move(r));
+                continue;
+            }
+            if (it->second.y == r.y)
+                continue;
+            relation combined;
+            combined.y = it->second.y * r.y % n;
+            combined.columns = it->second.columns;
+            combined.columns.insert(combined.columns.end(), r.columns.begin(), r.columns.end());
+            combined.square = it->second.square * r.square * static_cast<unsigned long>(large) % n;
+            full.push_back(std::move(combined));
+        }
+        f.fulls.clear();
+        f.partials.clear();
+        if (full.size() >= wanted)
+            enough.store(true);
+    }
+
+    /**
+     *  @brief Finds dependencies among the relations and tries them for a proper factor
+     *
+     *  The exponent matrix is shrunk first by structured elimination: a relation with a
+     *  column that no other relation has can not be part of a dependency and is dropped,
+     *  and the two relations that share a column no other relation has are merged into
+     *  one, which removes the column. The rest, one row per column and one bit per merged
+     *  relation, is brought to reduced row echelon form; each free relation together with
+     *  the pivots set in its column multiplies to a square.
+     *
+     *  @return a proper divisor of n, or 1
+     */
+    inline mpz_class quadraticSieve::solve()
+    {
+        // the columns with an odd exponent and the relations combined into one
+        struct merged
+        {
+            std::vector<uint32_t> odd;
+            std::vector<size_t> members;
+        };
+
+        size_t columnCount = base.size() + 1;
+        std::vector<merged> rels(full.size());
+        for (size_t j = 0; j < full.size(); ++j)
+        {
+            std::vector<uint32_t> columns = full[j].columns;
+            std::sort(columns.begin(), columns.end());
+            for (size_t i = 0; i < columns.size();)
+            {
+                size_t e = i;
+                while (e < columns.size() && columns[e] == columns[i])
+                    ++e;
+                if ((e - i) % 2 == 1)
+                    rels[j].odd.push_back(columns[i]);
+                i = e;
+            }
+            rels[j].members.push_back(j);
+        }
+
+        std::vector<char> alive(full.size(), 1), touched(full.size());
+        std::vector<std::vector<size_t>> holders(columnCount);
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (std::vector<size_t> &h : holders)
+                h.clear();
+            for (size_t j = 0; j < rels.size(); ++j)
+                if (alive[j])
+                    for (uint32_t c : rels[j].odd)
+                        holders[c].push_back(j);
+
+            // a relation changed in this pass is left for the next one, its holders are stale
+            std::fill(touched.begin(), touched.end(), 0);
+            for (const std::vector<size_t> &h : holders)
+            {
+                if (h.empty() || h.size() > 2 || touched[h[0]] || (h.size() == 2 && touched[h[1]]))
+                    continue;
+                if (h.size() == 2)
+                {
+                    merged &kept = rels[h[0]], &gone = rels[h[1]];
+                    std::vector<uint32_t> odd;
+                    std::set_symmetric_difference(kept.odd.begin(), kept.odd.end(), gone.odd.begin(), gone.odd.end(),
+                                                  std::back_inserter(odd));
+                    kept.odd = std::move(odd);
+                    kept.members.insert(kept.members.end(), gone.members.begin(), gone.members.end());
+                    touched[h[0]] = 1;
+                }
+                alive[h.back()] = 0;
+                touched[h.back()] = 1;
+                changed = true;
+            }
+        }
+
+        std::vector<size_t> weight(columnCount, 0);
+        for (size_t j = 0; j < rels.size(); ++j)
+            if (alive[j])
+                for (uint32_t c : rels[j].odd)
+                    ++weight[c];
+
+        std::vector<size_t> used;
+        std::vector<uint32_t> rowOf(columnCount, UINT32_MAX);
+        size_t rows = 0;
+        for (size_t c = 0; c < columnCount; ++c)
+            if (weight[c] > 0)
+                rowOf[c] = static_cast<uint32_t>(rows++);
+        for (size_t j = 0; j < rels.size() && used.size() < rows + 64; ++j)
+            if (alive[j])
+                used.push_back(j);
+        if (used.empty())
+            return 1;
+
+        size_t words = (used.size() + 63) / 64;
+        std::vector<uint64_t> matrix(std::max<size_t>(rows, 1) * words, 0);
+        for (size_t k = 0; k < used.size(); ++k)
+            for (uint32_t c : rels[used[k]].odd)
+                matrix[rowOf[c] * words + k / 64] ^= static_cast<uint64_t>(1) << (k % 64);
+
+        std::vector<size_t> pivotColumn;
+        std::vector<char> isPivot(used.size(), 0);
+        size_t rank = 0;
+        for (size_t k = 0; k < used.size() && rank < rows; ++k)
+        {
+            uint64_t mask = static_cast<uint64_t>(1) << (k % 64);
+            size_t r = rank;
+            while (r < rows && (matrix[r * words + k / 64] & mask) == 0)
+                ++r;
+            if (r == rows)
+                continue;
+            if (r != rank)
+                std::swap_ranges(matrix.begin() + r * words, matrix.begin() + (r + 1) * words,
+                                 matrix.begin() + rank * words);
+            const uint64_t *pivot = matrix.data() + rank * words;
+            for (size_t other = 0; other < rows; ++other)
+            {
+                uint64_t *row = matrix.data() + other * words;
+                if (other != rank && (row[k / 64] & mask) != 0)
+                    for (size_t w = 0; w < words; ++w)
+                        row[w] ^= pivot[w];
+            }
+            pivotColumn.push_back(k);
+            isPivot[k] = 1;
+            ++rank;
+        }
+
+        std::vector<uint32_t> exponents(columnCount);
+        for (size_t k = 0; k < used.size(); ++k)
+        {
+            if (isPivot[k])
+                continue;
+            std::vector<size_t> dependency = rels[used[k]].members;
+            uint64_t mask = static_cast<uint64_t>(1) << (k % 64);
+            for (size_t r = 0; r < rank; ++r)
+            {
+                if (matrix[r * words + k / 64] & mask)
+                {
+                    const std::vector<size_t> &members = rels[used[pivotColumn[r]]].members;
+                    dependency.insert(dependency.end(), members.begin(), members.end());
+                }
+            }
+
+            std::fill(exponents.begin(), exponents.end(), 0);
+            mpz_class x = 1, y = 1;
+            for (size_t j : dependency)
+            {
+                x = x * full[j].y % n;
+                y = y * full[j].square % n;
+                for (uint32_t c : full[j].columns)
+                    ++exponents[c];
+            }
+            for (size_t c = 1; c < columnCount; ++c)
+            {
+                if (exponents[c] == 0)
+                    continue;
+                mpz_class power, p = base[c - 1].prime;
+                mpz_powm_ui(power.get_mpz_t(), p.get_mpz_t(), exponents[c] / 2, n.get_mpz_t());
+                y = y * power % n;
+            }
+            mpz_class g = ::gcd(mpz_class(x - y), n);
+            if (g < 0)
+                g = -g;
+            if (g != 1 && g != n)
+                return g;
+        }
+        return 1;
+    }
+
+    /**
+     *  @brief Sieves until enough relations are known and combines them into a factor
+     *
+     *  A round that only finds trivial dependencies asks the workers for more relations;
+     *  after a few such rounds the search gives up.
+     *
+     *  @return a proper divisor of n, or 1
+     */
+    inline mpz_class quadraticSieve::run()
+    {
+        if (divisor != 1)
+            return divisor;
+        if (pool.size() < aFactors)
+            return 1;
+
+        size_t workers = workerCount(threads, 256);
+        for (size_t round = 0; round < 4; ++round)
+        {
+            parallelFor(workers, workers,
+                        [&](size_t begin, size_t end)
+                        {
+                            family f;
+                            for (size_t worker = begin; worker < end; ++worker)
+                            {
+                                while (!enough.load())
+                                {
+                                    drawA(f);
+                                    initFamily(f);
+                                    sieveFamily(f);
+                                }
+                            }
+                        });
+            mpz_class g = solve();
+            if (g != 1)
+                return g;
+            wanted = full.size() + 32;
+            enough.store(false);
+        }
+        return 1;
+    }
+
+    /**
+     *  @brief Splits a composite with the self-initializing quadratic sieve
+     *  @param n odd composite without small prime factors that is not a perfect power
+     *  @param threads number of workers, 0 for one per hardware thread
+     *  @return a proper divisor of n, or 1 if none was found
+     */
+    inline mpz_class siqsFindFactor(const mpz_class &n, size_t threads)
+    {
+        quadraticSieve sieve(n, threads);
+        return sieve.run();
+    }
+
+    /**
+     *  @brief Factorization using the self-initializing quadratic sieve
+     *  @param value number
+     *  @return vector of factors
+     */
+    template <typename T1>
+    template <typename T2>
+    std::vector<T2> modNum<T1>::SIQS<T2>::factor(T2 value)
+    {
+        return smoothFactor(value,
+                            [this](const mpz_class &n)
+                            {
+                                // the sieve can not split a perfect power, its (odd) root is a proper divisor
+                                if (mpz_perfect_power_p(n.get_mpz_t()))
+                                {
+                                    mpz_class root;
+                                    for (unsigned long e = 3;; e += 2)
+                                        if (mpz_root(root.get_mpz_t(), n.get_mpz_t(), e) != 0)
+                                            return root;
+                                }
+                                return siqsFindFactor(n, threads);
+                            });
+    }
+
+    template <typename T1>
+    std::vector<modNum<T1>> siqsFactorize(modNum<T1> value, size_t threads)
+    {
+        typename modNum<T1>::template SIQS<T1> strat(threads);
+        Adapter<T1> adapter(value.getValue(), value.getMod());
+        return adapter.factorizeMod(&strat);
+    }
+
+#endif
+} // namespace modular
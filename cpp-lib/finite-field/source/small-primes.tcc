@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "../mod-math.h"
+
+namespace modular
+{
+#ifndef SMALL_PRIMES
+#define SMALL_PRIMES
+
+    /**
+     *  @brief Entry of the small-prime table
+     *
+     *  For odd p, n is divisible by p exactly when n * inverse (mod 2^64) <= limit,
+     *  where inverse is p^-1 mod 2^64 and limit is (2^64 - 1) / p.
+     */
+    struct smallPrime
+    {
+        uint32_t prime;
+        uint64_t inverse;
+        uint64_t limit;
+    };
+
+    /**
+     *  @brief Counts primes below a bound by trial division
+     *  @param bound bound
+     *  @return number of primes in range [2, bound)
+     */
+    constexpr size_t countPrimesBelow(uint32_t bound)
+    {
+        size_t count = 0;
+        for (uint32_t n = 2; n < bound; ++n)
+        {
+            bool prime = true;
+            for (uint32_t d = 2; d * d <= n && prime; ++d)
+                prime = n % d != 0;
+            count += prime;
+        }
+        return count;
+    }
+
+    /**
+     *  @brief Builds the small-prime table at compile time
+     *  @return primes below smallPrimeBound with their inverses modulo 2^64
+     */
+    template <size_t N>
+    constexpr std::array<smallPrime, N> makeSmallPrimeTable()
+    {
+        std::array<smallPrime, N> table{};
+        size_t size = 0;
+        for (uint32_t n = 2; size < N; ++n)
+        {
+            bool prime = true;
+            for (size_t i = 0; i < size && table[i].prime * table[i].prime <= n && prime; ++i)
+                prime = n % table[i].prime != 0;
+            if (!prime)
+                continue;
+
+            uint64_t inverse = 0;
+            if (n % 2 == 1)
+            {
+                // Newton iteration, every step doubles the number of correct low bits
+                inverse = n;
+                for (int step = 0; step < 5; ++step)
+                    inverse *= 2 - n * inverse;
+            }
+            table[size++] = smallPrime{n, inverse, UINT64_MAX / n};
+        }
+        return table;
+    }
+
+    inline constexpr auto smallPrimeTable = makeSmallPrimeTable<countPrimesBelow(smallPrimeBound)>();
+
+    /**
+     *  @brief Small-prime pre-filter for a word
+     *  @param n value
+     *  @return verdict, unknown if n has no factor in the table and is at least smallPrimeBound^2
+     */
+    inline sieveVerdict smallPrimeFilterWord(uint64_t n)
+    {
+        if (n < 2)
+            return sieveVerdict::composite;
+        if (n % 2 == 0)
+            return n == 2 ? sieveVerdict::prime : sieveVerdict::composite;
+
+        for (size_t i = 1; i < smallPrimeTable.size(); ++i)
+        {
+            const smallPrime &entry = smallPrimeTable[i];
+            if (static_cast<uint64_t>(entry.prime) * entry.prime > n)
+                return sieveVerdict::prime;
+            if (n * entry.inverse <= entry.limit)
+                return sieveVerdict::composite;
+        }
+        return n < static_cast<uint64_t>(smallPrimeBound) * smallPrimeBound ? sieveVerdict::prime
+                                                                           : sieveVerdict::unknown;
+    }
+
+    /**
+     *  @brief Product of all primes in the table
+     *  @return primorial, built once
+     */
+    inline const mpz_class &smallPrimorial()
+    {
+        static const mpz_class primorial = []
+        {
+            mpz_class product = 1;
+            for (const smallPrime &entry : smallPrimeTable)
+                product *= static_cast<unsigned long>(entry.prime);
+            return product;
+        }();
+        return primorial;
+    }
+
+    /**
+     *  @brief Small-prime pre-filter
+     *  @param value value
+     *
+     *  Values below 2 are reported as composite.
+     *
+     *  @return verdict, unknown if value has no factor in the table and is at least smallPrimeBound^2
+     */
+    template <typename T>
+    sieveVerdict smallPrimeFilter(const T &value)
+    {
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            if (value < 2)
+                return sieveVerdict::composite;
+            if (mpz_sizeinbase(value.get_mpz_t(), 2) <= 64)
+                return smallPrimeFilterWord(static_cast<uint64_t>(mpz_getlimbn(value.get_mpz_t(), 0)));
+
+            mpz_class common;
+            mpz_gcd(common.get_mpz_t(), value.get_mpz_t(), smallPrimorial().get_mpz_t());
+            return common == 1 ? sieveVerdict::unknown : sieveVerdict::composite;
+        }
+        else
+        {
+            if (value < 2)
+                return sieveVerdict::composite;
+            if constexpr (sizeof(T) <= sizeof(uint64_t))
+            {
+                return smallPrimeFilterWord(static_cast<uint64_t>(value));
+            }
+            else
+            {
+                if (static_cast<uint64_t>(value >> 64) == 0)
+                    return smallPrimeFilterWord(static_cast<uint64_t>(value));
+                for (const smallPrime &entry : smallPrimeTable)
+                {
+                    if (value % entry.prime == 0)
+                        return sieveVerdict::composite;
+                }
+                return sieveVerdict::unknown;
+            }
+        }
+    }
+
+    /**
+     *  @brief Divides out every prime factor below smallPrimeBound
+     *  @param value positive value
+     *  @param visit called as visit(prime, exponent) for each prime factor found
+     *
+     *  Stops early once the square of the next prime exceeds the cofactor;
+     *  a remaining cofactor below smallPrimeBound is prime and is visited too.
+     *
+     *  @return cofactor without prime factors below smallPrimeBound
+     */
+    template <typename T, typename Visitor>
+    T stripSmallPrimes(T value, Visitor visit)
+    {
+        for (const smallPrime &entry : smallPrimeTable)
+        {
+            T prime = static_cast<T>(entry.prime);
+            if (prime * prime > value)
+            {
+                if (value > 1 && value < static_cast<T>(smallPrimeBound))
+                {
+                    visit(value, 1u);
+                    value = 1;
+                }
+                break;
+            }
+
+            unsigned exponent = 0;
+            while (value % prime == 0)
+            {
+                value /= prime;
+                exponent++;
+            }
+            if (exponent > 0)
+                visit(prime, exponent);
+        }
+        return value;
+    }
+
+#endif
+} // namespace modular
@@ -4,7 +4,7 @@
 #include <random>
 #include <set>
 
-#include "factorization.tcc"
+#include "factor-cache.tcc"
 #include "fpow.tcc"
 #include "isPrime.tcc"
 #include "mod-num.tcc"
@@ -24,6 +24,11 @@ namespace modular
     template <typename T>
     T legendreSymbol(T a, T n)
     {
+        if constexpr (std::is_same<T, mpz_class>::value)
+        {
+            // the Jacobi symbol equals the Legendre symbol for the odd prime moduli used here
+            return mpz_jacobi(a.get_mpz_t(), n.get_mpz_t());
+        }
         T one = 1;
         T minusOne = -1;
 
@@ -206,10 +211,10 @@ namespace modular
         T val = value.getValue();
         T n = value.getMod();
 
-        std::vector<modular::modNum<T>> factors =
-            modular::factorize(modular::modNum<T>(n, n + static_cast<T>(1)));
-        T p = factors[0].getValue();
-        T q = factors[1].getValue();
+        std::map<T, unsigned> factors = cachedFactorization(n);
+        auto first = factors.begin(), second = std::next(first);
+        T p = first->first;
+        T q = second == factors.end() ? p : second->first;
 
         std::vector<T> pRoots = sqrtPrime(modNum<T>(val, p));
         std::vector<T> qRoots = {};
@@ -0,0 +1,112 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <random>
+
+using namespace modular;
+
+TEST_CASE("Barrett reduction of word-size products")
+{
+    std::mt19937_64 gen(2024);
+
+    SUBCASE("Random moduli and products")
+    {
+        for (int i = 0; i < 100000; ++i)
+        {
+            uint64_t mod = gen() >> (gen() % 64);
+            if (mod == 0)
+                mod = 1;
+            BarrettReducer reducer(mod);
+            uint64_t a = gen() % mod, b = gen() % mod;
+            unsigned __int128 expected = static_cast<unsigned __int128>(a) * b % mod;
+            REQUIRE(reducer.mult(a, b) == static_cast<uint64_t>(expected));
+        }
+    }
+
+    SUBCASE("Moduli near 2^63 and 2^64")
+    {
+        for (uint64_t mod : {9223372036854775783ULL, 9223372036854775807ULL, 18446744073709551557ULL})
+        {
+            BarrettReducer reducer(mod);
+            uint64_t a = mod - 1;
+            CHECK_EQ(reducer.mult(a, a), static_cast<uint64_t>(1));
+            CHECK_EQ(reducer.reduce(~static_cast<unsigned __int128>(0)),
+                     static_cast<uint64_t>(~static_cast<unsigned __int128>(0) % mod));
+        }
+    }
+
+    SUBCASE("Zero modulus")
+    {
+        CHECK_THROWS_AS(BarrettReducer(0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Word-size modNum multiplication does not overflow")
+{
+    using T = long long;
+    T mod = 9223372036854775783LL;
+    modNum<T> a(mod - 1, mod), b(mod - 2, mod);
+    CHECK_EQ((a * b).getValue(), 2);
+    CHECK_EQ(fpow(a, static_cast<T>(1000001)).getValue(), mod - 1);
+    CHECK_EQ(fpow(modNum<T>(3, mod), mod - 1).getValue(), 1);
+}
+
+TEST_CASE("Unsigned modNum subtraction")
+{
+    using T = uint64_t;
+    T mod = 18446744073709551557ULL;
+    modNum<T> a(5, mod), b(7, mod);
+    CHECK_EQ((a - b).getValue(), mod - 2);
+    CHECK_EQ((b - a).getValue(), static_cast<T>(2));
+    CHECK_EQ((modNum<T>(mod - 1, mod) + modNum<T>(mod - 1, mod)).getValue(), mod - 2);
+}
+
+TEST_CASE("modNum operators share the reducer of their modulus")
+{
+    std::mt19937_64 gen(7);
+    for (int i = 0; i < 20000; ++i)
+    {
+        long long mod = static_cast<long long>(gen() >> (1 + gen() % 63));
+        if (mod == 0)
+            mod = 1;
+        long long x = static_cast<long long>(gen() % mod), y = static_cast<long long>(gen() % mod);
+        modNum<long long> a(x, mod), b(y, mod);
+        __int128 wide = mod;
+        REQUIRE((a + b).getValue() == static_cast<long long>((static_cast<__int128>(x) + y) % wide));
+        REQUIRE((a - b).getValue() == static_cast<long long>(((static_cast<__int128>(x) - y) % wide + wide) % wide));
+        REQUIRE((a * b).getValue() == static_cast<long long>(static_cast<__int128>(x) * y % wide));
+    }
+
+    modNum<long long> c(6, 7);
+    c.setMod(1000000007);
+    CHECK_EQ((c * modNum<long long>(500000004, 1000000007)).getValue(), 3);
+
+    // a smaller modulus reduces the value kept so far
+    modNum<long long> d(12, 13);
+    d.setMod(5);
+    CHECK_EQ(d.getValue(), 2);
+    CHECK_EQ((d + modNum<long long>(0, 5)).getValue(), 2);
+    CHECK_EQ((d - modNum<long long>(0, 5)).getValue(), 2);
+    modNum<mpz_class> e(12, 13);
+    e.setMod(5);
+    e += modNum<mpz_class>(0, 5);
+    CHECK_EQ(e.getValue(), 2);
+    e -= modNum<mpz_class>(0, 5);
+    CHECK_EQ(e.getValue(), 2);
+
+    // alternating moduli rebuild the shared reducer every time
+    modNum<long long> p(3, 1000000007), q(3, 998244353);
+    for (int i = 0; i < 10; ++i)
+    {
+        p *= p;
+        q *= q;
+    }
+    CHECK_EQ(p, fpow(modNum<long long>(3, 1000000007), 1024LL));
+    CHECK_EQ(q, fpow(modNum<long long>(3, 998244353), 1024LL));
+
+    // elements keep only the value, the modulus and the strategy pointer
+    CHECK(sizeof(modNum<int>) == 2 * sizeof(int) + sizeof(void *));
+    CHECK(sizeof(modNum<long long>) == 2 * sizeof(long long) + sizeof(void *));
+}
@@ -0,0 +1,65 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <gmpxx.h>
+#include <random>
+
+using namespace modular;
+
+TEST_CASE("Batch inversion with a prime modulus")
+{
+    using T = long long;
+    const T MOD = 1000000007;
+    std::vector<T> values, original;
+    for (int i = 0; i < 1000; ++i)
+        values.push_back(getRandomNumber<T>(1, MOD - 1));
+    original = values;
+
+    std::vector<bool> invertible = batchInverse(values, MOD);
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        REQUIRE(invertible[i]);
+        REQUIRE(values[i] == modNum<T>(original[i], MOD).inv().getValue());
+    }
+}
+
+TEST_CASE("Batch inversion reports non-invertible values")
+{
+    SUBCASE("Composite modulus")
+    {
+        std::vector<int> values = {1, 2, 3, 0, 7, 10, 11}, expected = {1, 8, 0, 0, 13, 0, 11};
+        std::vector<bool> invertible = batchInverse(values, 15);
+
+        std::vector<bool> expectedFlags = {true, true, false, false, true, false, true};
+        CHECK(invertible == expectedFlags);
+        for (size_t i = 0; i < values.size(); ++i)
+            if (invertible[i])
+                CHECK_EQ(values[i], expected[i]);
+        CHECK_EQ(values[2], 3);
+        CHECK_EQ(values[5], 10);
+    }
+
+    SUBCASE("Long arithmetic")
+    {
+        mpz_class mod = (mpz_class(1) << 127) - 1;
+        std::vector<mpz_class> values = {2, 3, mod, mpz_class(mod * 2 + 5)};
+        std::vector<bool> invertible = batchInverse(values, mod);
+
+        CHECK(invertible[0]);
+        CHECK(invertible[1]);
+        CHECK_FALSE(invertible[2]);
+        CHECK_EQ(values[2], 0);
+        CHECK(invertible[3]);
+        CHECK_EQ(mpz_class(values[0] * 2 % mod), mpz_class(1));
+        CHECK_EQ(mpz_class(values[3] * 5 % mod), mpz_class(1));
+    }
+
+    SUBCASE("Empty input")
+    {
+        std::vector<int> values;
+        CHECK(batchInverse(values, 7).empty());
+    }
+}
@@ -0,0 +1,67 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <gmpxx.h>
+#include <vector>
+
+using namespace modular;
+
+TEST_CASE("Batched exponentiation with built-in types")
+{
+    SUBCASE("Per-base powers, odd and even moduli")
+    {
+        for (long long mod : {1000000007LL, 1000000008LL, 1LL})
+        {
+            std::vector<long long> bases, powers;
+            for (int i = 0; i < 1000; ++i)
+            {
+                bases.push_back(getRandomNumber<long long>(-1000000000, 1000000000));
+                powers.push_back(getRandomNumber<long long>(1, 1000000000));
+            }
+            for (size_t threads : {1, 3, 0})
+            {
+                std::vector<long long> results = batchPow(bases, powers, mod, threads);
+                REQUIRE_EQ(results.size(), bases.size());
+                for (size_t i = 0; i < bases.size(); ++i)
+                    CHECK_EQ(results[i], fpow(modNum<long long>(bases[i], mod), powers[i]).getValue());
+            }
+        }
+    }
+
+    SUBCASE("Shared power")
+    {
+        std::vector<uint64_t> bases = {2, 3, 5, 7, 11};
+        uint64_t mod = 9223372036854775783ULL;
+        std::vector<uint64_t> results = batchPow(bases, std::vector<uint64_t>{mod - 1}, mod, 2);
+        for (uint64_t result : results)
+            CHECK_EQ(result, static_cast<uint64_t>(1));
+    }
+
+    SUBCASE("Invalid arguments")
+    {
+        std::vector<int> bases = {1, 2, 0};
+        CHECK_THROWS_AS(batchPow(bases, std::vector<int>{1, 2}, 7), std::invalid_argument);
+        CHECK_THROWS_AS(batchPow(bases, std::vector<int>{1}, 0), std::invalid_argument);
+        CHECK_THROWS_AS(batchPow(bases, std::vector<int>{1, 1, 0}, 7, 3), std::invalid_argument);
+        CHECK(batchPow(std::vector<int>{}, std::vector<int>{}, 7).empty());
+    }
+}
+
+TEST_CASE("Batched exponentiation with mpz_class")
+{
+    mpz_class odd("627917618844137493480783674921"), even("627917618844137493480783674920");
+    std::vector<mpz_class> bases, powers;
+    for (int i = 0; i < 50; ++i)
+    {
+        bases.push_back(mpz_class("84768435013152452201149402649") * i - 17);
+        powers.push_back(mpz_class("1311790816646986218444823") + i);
+    }
+    for (const mpz_class &mod : {odd, even})
+    {
+        std::vector<mpz_class> results = batchPow(bases, powers, mod, 4);
+        for (size_t i = 0; i < bases.size(); ++i)
+            CHECK_EQ(results[i], fpow(modNum<mpz_class>(bases[i], mod), powers[i], powEngine::classic).getValue());
+    }
+}
@@ -0,0 +1,94 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <algorithm>
+#include <vector>
+
+using namespace modular;
+
+void checkFactorization(const mpz_class &n, const std::vector<mpz_class> &factors)
+{
+    mpz_class product = 1;
+    for (const mpz_class &f : factors)
+    {
+        CHECK(mpz_probab_prime_p(f.get_mpz_t(), 30) != 0);
+        product *= f;
+    }
+    CHECK_EQ(product, n);
+}
+
+TEST_CASE("Montgomery curve arithmetic")
+{
+    // on a prime modulus the ladder must agree with repeated differential additions
+    mpz_class p("1000000000000000000000007"), factor;
+    ecmPoint start;
+    montgomeryCurve curve(p, mpz_class(11), start, factor);
+    REQUIRE_EQ(factor, 1);
+
+    ecmPoint previous = start, current, next;
+    curve.dbl(current, start);
+    for (uint64_t k = 3; k <= 50; ++k)
+    {
+        curve.add(next, current, start, previous);
+        previous = current;
+        current = next;
+
+        ecmPoint ladder;
+        curve.mul(ladder, k, start);
+        mpz_class lhs = ladder.x * current.z - current.x * ladder.z;
+        CHECK_EQ(mpz_class(lhs % p), 0);
+    }
+}
+
+TEST_CASE("ECM factorization")
+{
+    setRandomSeed(5);
+
+    SUBCASE("Factors beyond the reach of rho")
+    {
+        mpz_class p("1000000000000037"), q("1000000000000000000000000000057");
+        mpz_class n = p * q;
+        mpz_class factor = ecmFindFactor(n, 0, 20);
+        CHECK((factor == p || factor == q));
+
+        std::vector<mpz_class> factors = modNum<mpz_class>::ECM<mpz_class>(0, 20).factor(n);
+        std::sort(factors.begin(), factors.end());
+        CHECK((factors == std::vector<mpz_class>{p, q}));
+    }
+
+    SUBCASE("Mixed factorizations")
+    {
+        mpz_class p("4294967311"), q("1000000000039"), r("10000000000000061");
+        for (mpz_class n : {mpz_class(p * q * r), mpz_class(q * q * q * r * 12), mpz_class(r * r * 1031)})
+            checkFactorization(n, modNum<mpz_class>::ECM<mpz_class>().factor(n));
+
+        std::vector<long long> words = modNum<long long>::ECM<long long>().factor(1000000007LL * 999999937LL);
+        std::sort(words.begin(), words.end());
+        CHECK((words == std::vector<long long>{999999937LL, 1000000007LL}));
+    }
+
+    SUBCASE("Threaded curves repeat after setRandomSeed")
+    {
+        mpz_class p("1000000000000037"), q("1000000000000000000000000000057");
+        auto run = [&p, &q]
+        {
+            setRandomSeed(9);
+            mpz_class factor = ecmFindFactor(p * q, 4, 20);
+            return std::make_pair(factor, randomBelow(q));
+        };
+        auto first = run();
+        CHECK((first.first == p || first.first == q));
+        CHECK((run() == first));
+    }
+
+    SUBCASE("Through modNum")
+    {
+        mpz_class n = mpz_class("1000000000000037") * mpz_class("100000000000000003");
+        std::vector<modNum<mpz_class>> factors = ecmFactorize(modNum<mpz_class>(n, n + 1), 2);
+        CHECK_EQ(factors.size(), 2);
+        CHECK_EQ(factors[0].getValue() * factors[1].getValue(), n);
+        CHECK_THROWS_AS(ecmFactorize(modNum<mpz_class>(0, 7)), std::invalid_argument);
+    }
+}
@@ -26,6 +26,12 @@ TEST_CASE("EULER_FROM_WOLFRAM"){
     CHECK_EQ(ans,res);    
 }
 
+TEST_CASE("Largest values of the type"){
+    CHECK_EQ(EulerFunction<int>(2147483647), 2147483646);
+    CHECK_EQ(CarmichaelFunction<int>(2147483647), 2147483646);
+    CHECK_EQ(EulerFunction<long long>(9223372036854775807LL), 7713001620195508224LL);
+}
+
 TEST_CASE("CARMICHAEL_CHECK"){
     mpz_class actual[] = {1, 1, 2, 2, 4, 2, 6, 2, 6, 4, 10, 2, 12, 6, 4, 4, 16, 6, 18, 4, 6, 10, 22, 2, 20, 12, 18, 6, 28, 4, 30, 8, 10, 16, 12, 6, 36, 18, 12, 4, 40, 6, 42, 10, 12, 22, 46, 4, 42, 20, 16, 12, 52, 18, 20, 6, 18, 28, 58, 4, 60, 30, 6, 16, 12, 10, 66, 16, 22, 12, 70, 6, 72, 36, 20, 18, 30, 12, 78, 4, 54};
     for (int i=1; i<=81; i++){
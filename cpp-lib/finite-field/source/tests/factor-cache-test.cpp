@@ -0,0 +1,121 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace modular;
+
+TEST_CASE("Cache entries")
+{
+    factorCache cache(3);
+    std::map<long long, unsigned> factors;
+    CHECK_FALSE(cache.lookup(12LL, factors));
+
+    cache.insert(12LL, std::map<long long, unsigned>{{2, 2}, {3, 1}});
+    REQUIRE(cache.lookup(12LL, factors));
+    CHECK((factors == std::map<long long, unsigned>{{2, 2}, {3, 1}}));
+
+    // entries are shared between integer types
+    std::map<mpz_class, unsigned> wide;
+    REQUIRE(cache.lookup(mpz_class(12), wide));
+    CHECK((wide == std::map<mpz_class, unsigned>{{2, 2}, {3, 1}}));
+
+    mpz_class big("340282366920938463463374607431768211457");
+    cache.insert(big, std::map<mpz_class, unsigned>{{big, 1}});
+    CHECK(cache.lookup(big, wide));
+    CHECK_EQ(wide.begin()->first, big);
+}
+
+TEST_CASE("Least recently used entry is dropped")
+{
+    factorCache cache(3);
+    std::map<long long, unsigned> factors;
+    cache.insert(12LL, std::map<long long, unsigned>{{2, 2}, {3, 1}});
+    cache.insert(30LL, std::map<long long, unsigned>{{2, 1}, {3, 1}, {5, 1}});
+    cache.insert(7LL, std::map<long long, unsigned>{{7, 1}});
+    CHECK(cache.lookup(12LL, factors));
+    cache.insert(8LL, std::map<long long, unsigned>{{2, 3}});
+    CHECK_EQ(cache.size(), 3);
+    CHECK_FALSE(cache.lookup(30LL, factors));
+    CHECK(cache.lookup(12LL, factors));
+
+    cache.setCapacity(1);
+    CHECK_EQ(cache.size(), 1);
+    CHECK(cache.lookup(12LL, factors));
+    cache.clear();
+    CHECK_EQ(cache.size(), 0);
+}
+
+TEST_CASE("Cache files")
+{
+    const std::string path = "factor-cache-test.bin";
+    factorCache cache;
+    mpz_class big = mpz_class("1000000000000037") * mpz_class("1000000000000000000000000000057");
+    cache.insert(big, std::map<mpz_class, unsigned>{{mpz_class("1000000000000037"), 1},
+                                                    {mpz_class("1000000000000000000000000000057"), 1}});
+    cache.insert(1024LL, std::map<long long, unsigned>{{2, 10}});
+    cache.insert(1LL, std::map<long long, unsigned>{});
+    cache.save(path);
+
+    factorCache restored(2);
+    restored.load(path);
+    CHECK_EQ(restored.size(), 2);
+    std::map<mpz_class, unsigned> factors;
+    // the oldest entry did not fit
+    CHECK_FALSE(restored.lookup(big, factors));
+    CHECK(restored.lookup(mpz_class(1024), factors));
+    CHECK((factors == std::map<mpz_class, unsigned>{{2, 10}}));
+    CHECK(restored.lookup(mpz_class(1), factors));
+    CHECK(factors.empty());
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "FCACHE1";
+        out.put('\0');
+        out.put(static_cast<char>(5));
+    }
+    CHECK_THROWS_AS(restored.load(path), std::invalid_argument);
+    CHECK_EQ(restored.size(), 2);
+    std::remove(path.c_str());
+    CHECK_THROWS_AS(restored.load(path), std::invalid_argument);
+}
+
+TEST_CASE("Number-theoretic functions share the cache")
+{
+    factorCache &cache = sharedFactorCache();
+    cache.clear();
+
+    long long p = 1000000007LL;
+    CHECK(isGenerator(modNum<long long>(5, p)));
+    std::map<long long, unsigned> factors;
+    REQUIRE(cache.lookup(p - 1, factors));
+    CHECK((factors == std::map<long long, unsigned>{{2, 1}, {500000003, 1}}));
+
+    // a planted entry is used as is
+    cache.insert(15LL, std::map<long long, unsigned>{{3, 1}, {5, 1}});
+    CHECK_EQ(EulerFunction(15LL), 8);
+    CHECK_EQ(CarmichaelFunction(15LL), 4);
+    CHECK_EQ(EulerFunction(1031LL * 1033LL), 1030LL * 1032LL);
+    CHECK(cache.lookup(1031LL * 1033LL, factors));
+
+    std::vector<std::thread> workers;
+    std::vector<long long> results(8);
+    for (size_t i = 0; i < results.size(); ++i)
+        workers.emplace_back([&results, i]() { results[i] = EulerFunction(static_cast<long long>(1000 + i)); });
+    for (std::thread &worker : workers)
+        worker.join();
+    CHECK_EQ(results[0], 400);
+    CHECK_EQ(results[1], 720);
+
+    // narrow types are factored directly and leave the cache alone
+    cache.clear();
+    for (int n = 1; n <= 1000; ++n)
+        CHECK(CarmichaelFunction(n) <= EulerFunction(n));
+    CHECK_EQ(EulerFunction(1000), 400);
+    CHECK_EQ(cache.size(), 0);
+}
@@ -0,0 +1,84 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <gmpxx.h>
+#include <thread>
+#include <vector>
+
+using namespace modular;
+
+TEST_CASE("Fixed-base exponentiation with built-in types")
+{
+    SUBCASE("Matches fpow for every table size")
+    {
+        long long mod = 1000000007;
+        modNum<long long> base(5, mod);
+        for (size_t teeth : {1, 2, 5, 8, 16})
+        {
+            fixedBasePow<long long> powers(base, 0, teeth);
+            CHECK_EQ(powers.getTableSize(), static_cast<size_t>(1) << teeth);
+            CHECK(powers.getMaxBits() >= 30);
+            for (int i = 0; i < 200; ++i)
+            {
+                long long pw = getRandomNumber<long long>(0, mod - 1);
+                CHECK(powers.pow(pw) == fpow(base, pw));
+            }
+            CHECK_EQ(powers.pow(0).getValue(), 1);
+        }
+    }
+
+    SUBCASE("Exponents longer than the table")
+    {
+        uint64_t mod = 9223372036854775783ULL;
+        modNum<uint64_t> base(3, mod);
+        fixedBasePow<uint64_t> powers(base, 16, 4);
+        CHECK_EQ(powers.getMaxBits(), static_cast<size_t>(16));
+        CHECK(powers.pow(65535) == fpow(base, static_cast<uint64_t>(65535)));
+        CHECK(powers.pow(mod - 1) == fpow(base, mod - 1));
+    }
+
+    SUBCASE("Invalid arguments")
+    {
+        CHECK_THROWS_AS(fixedBasePow<int>(modNum<int>(2, 7), 0, 0), std::invalid_argument);
+        CHECK_THROWS_AS(fixedBasePow<int>(modNum<int>(2, 7), 0, 17), std::invalid_argument);
+        CHECK_THROWS_AS(fixedBasePow<int>(modNum<int>(0, 7)).pow(0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Fixed-base exponentiation with mpz_class")
+{
+    mpz_class mod("627917618844137493480783674921"), base("84768435013152452201149402649");
+    fixedBasePow<mpz_class> powers(modNum<mpz_class>(base, mod), 0, 8);
+    mpz_class pw("1311790816646986218444823");
+    for (int i = 0; i < 20; ++i)
+    {
+        mpz_class expected;
+        mpz_powm(expected.get_mpz_t(), base.get_mpz_t(), pw.get_mpz_t(), mod.get_mpz_t());
+        CHECK_EQ(powers.pow(pw).getValue(), expected);
+        pw = pw * 7 + 3;
+    }
+}
+
+TEST_CASE("Shared read-only between threads")
+{
+    long long mod = 998244353;
+    modNum<long long> base(3, mod);
+    const fixedBasePow<long long> powers(base);
+    std::vector<int> mismatches(4, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back(
+            [&, t]()
+            {
+                for (long long pw = t; pw < 20000; pw += 4)
+                    mismatches[t] += !(powers.pow(pw) == fpow(base, pw));
+            });
+    }
+    for (auto &worker : workers)
+        worker.join();
+    for (int count : mismatches)
+        CHECK_EQ(count, 0);
+}
@@ -0,0 +1,72 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <random>
+
+using namespace modular;
+
+template <typename T, T MOD>
+void checkAgainstModNum(std::mt19937_64 &gen)
+{
+    for (int i = 0; i < 10000; ++i)
+    {
+        T a = static_cast<T>(gen() % MOD), b = static_cast<T>(gen() % MOD);
+        fixedModNum<T, MOD> x(a), y(b);
+        modNum<T> u(a, MOD), v(b, MOD);
+
+        REQUIRE_EQ((x + y).getValue(), (u + v).getValue());
+        REQUIRE_EQ((x - y).getValue(), (u - v).getValue());
+        REQUIRE_EQ((x * y).getValue(), (u * v).getValue());
+    }
+}
+
+TEST_CASE("Compile-time moduli of every reduction kind")
+{
+    std::mt19937_64 gen(7);
+
+    SUBCASE("Mersenne primes")
+    {
+        checkAgainstModNum<long long, (1LL << 61) - 1>(gen);
+        checkAgainstModNum<long long, (1LL << 31) - 1>(gen);
+    }
+
+    SUBCASE("Pseudo-Mersenne prime 2^62 - 57")
+    {
+        checkAgainstModNum<unsigned long long, (1ULL << 62) - 57>(gen);
+    }
+
+    SUBCASE("Small prime 998244353")
+    {
+        checkAgainstModNum<long long, 998244353>(gen);
+        checkAgainstModNum<int, 998244353>(gen);
+    }
+
+    SUBCASE("Generic 64-bit prime")
+    {
+        checkAgainstModNum<long long, 4611686018427387847LL>(gen);
+    }
+}
+
+TEST_CASE("Compile-time modulus in free functions")
+{
+    using T = long long;
+    using F = fixedModNum<T, 998244353>;
+
+    CHECK_EQ(F(-1).getValue(), 998244352);
+    CHECK_EQ(fpow(F(3), static_cast<T>(998244352)).getValue(), 1);
+    CHECK_EQ((F(5) / F(7) * F(7)).getValue(), 5);
+    CHECK(isGenerator(F(3)));
+    CHECK(!isGenerator(F(4)));
+
+    using G = fixedModNum<T, 103>;
+    T lg = log(G(3), G(5));
+    CHECK_EQ(fpow(G(5), lg).getValue(), 3);
+
+    std::vector<T> roots = sqrt(G(4)), expected = {2, 101};
+    CHECK(roots == expected);
+
+    static_assert(fixedModNum<T, (1LL << 61) - 1>(5).getValue() == 5, "constexpr construction");
+    static_assert((fixedModNum<T, 13>(5) * fixedModNum<T, 13>(6)).getValue() == 4, "constexpr product");
+}
@@ -0,0 +1,60 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <chrono>
+#include <gmpxx.h>
+#include <iostream>
+#include <string>
+
+using namespace modular;
+
+template <typename F>
+double measureMs(F &&body, int repeats)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i)
+        body(i);
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+template <typename T>
+void compareEngines(const std::string &name, const T &mod, const T &power, int repeats)
+{
+    // the base changes every call, so nothing can be hoisted out of the loop
+    T checksumClassic = 0, checksumMontgomery = 0;
+    double classicMs = measureMs(
+        [&](int i) { checksumClassic += fpow(modNum<T>(T(mod / 3 + i), mod), power, powEngine::classic).getValue(); },
+        repeats);
+    double montgomeryMs = measureMs(
+        [&](int i)
+        { checksumMontgomery += fpow(modNum<T>(T(mod / 3 + i), mod), power, powEngine::montgomery).getValue(); },
+        repeats);
+
+    CHECK(checksumClassic == checksumMontgomery);
+    std::cout << name << ": classicLogPow " << classicMs << " ms, Montgomery " << montgomeryMs
+              << " ms, speedup " << classicMs / montgomeryMs << "x\n";
+}
+
+TEST_CASE("Montgomery engine against classicLogPow")
+{
+    SUBCASE("64-bit modulus")
+    {
+        // checksums wrap around, so an unsigned type is used
+        uint64_t mod = 4611686018427387847ULL;
+        compareEngines<uint64_t>("64-bit", mod, mod - 2, 100000);
+    }
+
+    SUBCASE("Long moduli")
+    {
+        for (int bits : {256, 1024, 2048})
+        {
+            mpz_class mod;
+            mpz_ui_pow_ui(mod.get_mpz_t(), 2, bits);
+            mpz_nextprime(mod.get_mpz_t(), mpz_class(mod - 1000).get_mpz_t());
+            compareEngines<mpz_class>(std::to_string(bits) + "-bit", mod, mpz_class(mod - 2), bits >= 2048 ? 5 : 50);
+        }
+    }
+}
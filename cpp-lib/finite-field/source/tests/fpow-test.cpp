@@ -17,3 +17,84 @@ TEST_CASE("randomized test 1..1000 with mod 13")
         CHECK_EQ(fpow(modNum(num, 13), pw).getValue(), logPow(num, pw, 13));
     }
 }
+
+TEST_CASE("Exponentiation engines agree")
+{
+    SUBCASE("Built-in types")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            long long mod = getRandomNumber<long long>(2, 1000000000);
+            long long num = getRandomNumber<long long>(1, 1000000000);
+            long long pw = getRandomNumber<long long>(0, 1000000000);
+            modNum<long long> value(num, mod);
+            modNum<long long> expected = fpow(value, pw, powEngine::classic);
+            CHECK(fpow(value, pw, powEngine::montgomery) == expected);
+            CHECK(fpow(value, pw, powEngine::automatic) == expected);
+        }
+    }
+
+    SUBCASE("Moduli close to the type limit")
+    {
+        uint64_t mod = 9223372036854775783ULL;
+        modNum<uint64_t> value(mod - 1, mod);
+        CHECK_EQ(fpow(value, static_cast<uint64_t>(3), powEngine::montgomery).getValue(), mod - 1);
+        CHECK_EQ(fpow(value, static_cast<uint64_t>(2), powEngine::montgomery).getValue(), static_cast<uint64_t>(1));
+
+        uint64_t wordMod = 18446744073709551557ULL; // no spare bit, falls back to the classic engine
+        modNum<uint64_t> big(wordMod - 1, wordMod);
+        CHECK_EQ(fpow(big, static_cast<uint64_t>(2), powEngine::montgomery).getValue(), static_cast<uint64_t>(1));
+    }
+
+    SUBCASE("Long arithmetic, odd and even moduli")
+    {
+        mpz_class odd("627917618844137493480783674921"), even("627917618844137493480783674920");
+        mpz_class num("84768435013152452201149402649"), pw("1311790816646986218444823");
+        for (const mpz_class &mod : {odd, even})
+        {
+            modNum<mpz_class> value(num, mod);
+            CHECK(fpow(value, pw, powEngine::montgomery) == fpow(value, pw, powEngine::classic));
+        }
+    }
+
+    SUBCASE("0 pow 0")
+    {
+        CHECK_THROWS_AS(fpow(modNum<int>(0, 7), 0, powEngine::montgomery), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Sliding-window exponentiation")
+{
+    SUBCASE("Matches the binary ladder on every window size")
+    {
+        mpz_class mod("627917618844137493480783674921"), base("84768435013152452201149402649");
+        for (int bits : {1, 5, 9, 20, 60, 100, 500, 1000, 2100})
+        {
+            mpz_class power;
+            mpz_ui_pow_ui(power.get_mpz_t(), 3, bits);
+            mpz_class expected;
+            mpz_powm(expected.get_mpz_t(), base.get_mpz_t(), power.get_mpz_t(), mod.get_mpz_t());
+            CHECK_EQ(fpow(modNum<mpz_class>(base, mod), power, powEngine::classic).getValue(), expected);
+        }
+    }
+
+    SUBCASE("Fewer multiplications than the binary ladder")
+    {
+        mpz_class power;
+        mpz_ui_pow_ui(power.get_mpz_t(), 7, 730); // 2050 bits
+        size_t count = 0;
+        long long result = slidingWindowPow(3LL, power, 1LL,
+                                            [&count](long long &a, const long long &b)
+                                            {
+                                                a = a * b % 1000003;
+                                                count++;
+                                            });
+        mpz_class expected;
+        mpz_powm(expected.get_mpz_t(), mpz_class(3).get_mpz_t(), power.get_mpz_t(), mpz_class(1000003).get_mpz_t());
+        CHECK_EQ(result, expected.get_si());
+
+        size_t bits = mpz_sizeinbase(power.get_mpz_t(), 2), ones = mpz_popcount(power.get_mpz_t());
+        size_t binary = bits - 1 + ones - 1;
+        CHECK_LT(count * 10, binary * 8);
+    }
+}
@@ -0,0 +1,79 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <gmpxx.h>
+#include <numeric>
+#include <random>
+
+using namespace modular;
+
+TEST_CASE("Extended GCD")
+{
+    SUBCASE("Random built-in values")
+    {
+        using T = long long;
+        for (int i = 0; i < 10000; ++i)
+        {
+            T a = getRandomNumber<T>(0, 1000000), b = getRandomNumber<T>(0, 1000000);
+            T x, y;
+            T g = extendedGcd(a, b, x, y);
+            REQUIRE(a * x + b * y == g);
+            REQUIRE(g == std::gcd(a, b));
+        }
+    }
+
+    SUBCASE("Zero arguments")
+    {
+        int x, y;
+        CHECK_EQ(extendedGcd(0, 7, x, y), 7);
+        CHECK_EQ(x, 0);
+        CHECK_EQ(y, 1);
+        CHECK_EQ(extendedGcd(7, 0, x, y), 7);
+        CHECK_EQ(x, 1);
+        CHECK_EQ(y, 0);
+    }
+
+    SUBCASE("Long arithmetic")
+    {
+        mpz_class a, b, x, y;
+        a.set_str("627917618844137493480783674921", 10);
+        b.set_str("84768435013152452201149402649", 10);
+        mpz_class g = extendedGcd(a, b, x, y);
+        CHECK_EQ(a * x + b * y, g);
+        CHECK_EQ(g, mpz_class(gcd(a, b)));
+    }
+}
+
+TEST_CASE("Modular inverse")
+{
+    SUBCASE("Word moduli up to 2^64")
+    {
+        using T = uint64_t;
+        std::mt19937_64 gen(1);
+        T mod = 18446744073709551557ULL;
+        for (int i = 0; i < 1000; ++i)
+        {
+            T a = gen() % (mod - 1) + 1;
+            T inv = modInverse(a, mod);
+            REQUIRE(static_cast<unsigned __int128>(a) * inv % mod == 1);
+        }
+    }
+
+    SUBCASE("Thousand-bit modulus")
+    {
+        mpz_class mod = (mpz_class(1) << 1279) - 1; // Mersenne prime
+        mpz_class a = (mpz_class(1) << 1000) + 12345;
+        mpz_class inv = modInverse(a, mod);
+        CHECK_EQ(mpz_class(a * inv % mod), mpz_class(1));
+        CHECK((modNum<mpz_class>(a, mod) / modNum<mpz_class>(a, mod)).getValue() == 1);
+    }
+
+    SUBCASE("Non-invertible values")
+    {
+        CHECK_THROWS_AS(modInverse(30, 90), std::invalid_argument);
+        CHECK_THROWS_AS(modInverse(mpz_class(30), mpz_class(90)), std::invalid_argument);
+        CHECK_THROWS_AS(modInverse(0LL, 7LL), std::invalid_argument);
+    }
+}
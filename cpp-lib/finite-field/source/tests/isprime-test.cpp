@@ -115,18 +115,50 @@ TEST_CASE("Testing the Miller-Rabin method to check a number for prime ")
 
         CHECK_EQ(isPrime(modNum<T>(value, mod), k), SimpleIsPrime(value));
 
-        std::ofstream outfile(
-            "C:\\Users\\User\\Desktop\\PI-23\\Sem 2\\General "
-            "Algebra\\algebra-group-project-vsc\\files\\output.txt");
-        if (outfile.is_open())
-        {
-            if (isPrime(modNum<T>(value, mod), k))
-                outfile << "Your number is prime" << std::endl;
-            else
-                outfile << "Your number is NOT prime" << std::endl;
+        input.close();
+    }
+}
+TEST_CASE("Deterministic primality test")
+{
+    using T = long long;
+    T mod = 9223372036854775807LL;
+
+    SUBCASE("Carmichael numbers and strong pseudoprimes")
+    {
+        for (T value : {561LL, 1105LL, 1729LL, 2047LL, 3215031751LL, 2152302898747LL,
+                        3474749660383LL, 341550071728321LL, 3825123056546413051LL})
+            CHECK_FALSE(isPrime(modNum<T>(value, mod), 1));
+    }
 
-            outfile.close();
+    SUBCASE("Word-sized primes")
+    {
+        for (T value : {2LL, 3LL, 1009LL, 1000000007LL, 2305843009213693951LL, 9223372036854775783LL})
+            CHECK(isPrime(modNum<T>(value, mod), 1));
+        CHECK_FALSE(isPrime(modNum<T>(1681, mod), 1));
+        CHECK_FALSE(isPrime(modNum<T>(1000000007LL * 998244353LL, mod), 1));
+    }
+
+    SUBCASE("Agreement with GMP")
+    {
+        mpz_class big = 1;
+        big <<= 64;
+        for (int i = 0; i < 2000; ++i, big += 1)
+        {
+            bool expected = mpz_probab_prime_p(big.get_mpz_t(), 30) != 0;
+            CHECK_EQ(isPrime(modNum<mpz_class>(big, big + 1), 1), expected);
         }
-        input.close();
+        mpz_class start = 1000000;
+        for (mpz_class value = start; value < start + 2000; value += 1)
+            CHECK_EQ(isPrime(modNum<mpz_class>(value, value + 1), 1),
+                     mpz_probab_prime_p(value.get_mpz_t(), 30) != 0);
     }
-}
\ No newline at end of file
+
+    SUBCASE("Large composites")
+    {
+        mpz_class p("170141183460469231731687303715884105727"), q("618970019642690137449562111");
+        CHECK(isPrime(modNum<mpz_class>(p, p + 1), 1));
+        CHECK(isPrime(modNum<mpz_class>(q, q + 1), 1));
+        CHECK_FALSE(isPrime(modNum<mpz_class>(p * q, p * q + 1), 1));
+        CHECK_FALSE(isPrime(modNum<mpz_class>(p * p, p * p + 1), 1));
+    }
+}
@@ -0,0 +1,69 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <gmpxx.h>
+
+using namespace modular;
+
+TEST_CASE("GMP-backed modNum<mpz_class>")
+{
+    mpz_class mod("627917618844137493480783674921");
+    mpz_class x("84768435013152452201149402649"), y("1311790816646986218444823");
+    modNum<mpz_class> a(x, mod), b(y, mod);
+
+    SUBCASE("Arithmetic matches plain mpz expressions")
+    {
+        CHECK_EQ((a + b).getValue(), mpz_class((x + y) % mod));
+        CHECK_EQ((b - a).getValue(), mpz_class(((y - x) % mod + mod) % mod));
+        CHECK_EQ((a * b).getValue(), mpz_class(x * y % mod));
+        CHECK((a / b) * b == a);
+        CHECK(a * a.inv() == modNum<mpz_class>(1, mod));
+
+        modNum<mpz_class> acc(1, mod);
+        mpz_class expected = 1;
+        for (int i = 0; i < 100; ++i)
+        {
+            acc *= a;
+            acc += b;
+            acc -= modNum<mpz_class>(i, mod);
+            expected = ((expected * x + y - i) % mod + mod) % mod;
+        }
+        CHECK_EQ(acc.getValue(), expected);
+    }
+
+    SUBCASE("setValue reduces negative values")
+    {
+        modNum<mpz_class> c(0, mod);
+        c.setValue(mpz_class(-1));
+        CHECK_EQ(c.getValue(), mpz_class(mod - 1));
+    }
+
+    SUBCASE("Non-invertible values")
+    {
+        modNum<mpz_class> zero(0, mod), even(4, mpz_class(10));
+        CHECK_THROWS_AS(zero.inv(), std::invalid_argument);
+        CHECK_THROWS_AS(a / zero, std::invalid_argument);
+        CHECK_THROWS_AS(even.inv(), std::invalid_argument);
+    }
+
+    SUBCASE("Powers for odd and even moduli go through mpz_powm")
+    {
+        mpz_class even = mod + 1, expected;
+        for (const mpz_class &m : {mod, even})
+        {
+            mpz_powm(expected.get_mpz_t(), x.get_mpz_t(), y.get_mpz_t(), m.get_mpz_t());
+            CHECK_EQ(fpow(modNum<mpz_class>(x, m), y).getValue(), expected);
+            CHECK_EQ(fpow(modNum<mpz_class>(x, m), y, powEngine::classic).getValue(), expected);
+        }
+    }
+
+    SUBCASE("Primality and Legendre symbol")
+    {
+        CHECK(isPrime(modNum<mpz_class>(mod, mod + 1), 25));
+        CHECK_FALSE(isPrime(modNum<mpz_class>(mpz_class(mod * 3), mod * 4), 25));
+        for (int value = 1; value < 50; ++value)
+            CHECK_EQ(legendreSymbol(mpz_class(value), mpz_class(101)), mpz_class(legendreSymbol(value, 101)));
+    }
+}
@@ -2,6 +2,7 @@
 #include "../../../doctest.h"
 #include "../../mod-math.h"
 #include "utils.h"
+#include <gmpxx.h>
 #include <random>
 
 using namespace modular;
@@ -51,4 +52,83 @@ TEST_CASE("Testing modNum class with random values")
         modNum<T> result = a.inv();
         REQUIRE(result.getValue() * a.getValue() % MOD == static_cast<T>(1));
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Compound operators and temporaries")
+{
+    SUBCASE("Built-in types")
+    {
+        using T = long long;
+        const T MOD = 1000000007;
+        modNum<T> a(123456789, MOD), b(987654321, MOD);
+
+        modNum<T> c = a;
+        c += b;
+        REQUIRE(c == a + b);
+        c -= b;
+        REQUIRE(c == a);
+        c *= b;
+        REQUIRE(c == a * b);
+        c /= b;
+        REQUIRE(c == a);
+
+        REQUIRE(modNum<T>(a) * b + a == a * b + a);
+        REQUIRE(modNum<T>(5, MOD, reducedTag()).getValue() == 5);
+    }
+
+    SUBCASE("Long arithmetic")
+    {
+        mpz_class mod, x, y;
+        mod.set_str("627917618844137493480783674921", 10);
+        x.set_str("1311790816646986218444823", 10);
+        y.set_str("627917618844137493480783674920", 10);
+        modNum<mpz_class> a(x, mod), b(y, mod);
+
+        modNum<mpz_class> c = a;
+        c += b;
+        REQUIRE(c.getValue() == x - 1);
+        c -= b;
+        REQUIRE(c == a);
+        c *= b;
+        REQUIRE(c.getValue() == mod - x);
+        c /= b;
+        REQUIRE(c == a);
+    }
+}
+
+TEST_CASE("Operands with another modulus are reduced first")
+{
+    using T = long long;
+
+    SUBCASE("Addition")
+    {
+        modNum<T> result = modNum<T>(5, 7) + modNum<T>(100, 1000);
+        REQUIRE(result.getValue() == 0);
+        REQUIRE(result.getMod() == 7);
+    }
+
+    SUBCASE("Subtraction")
+    {
+        modNum<T> result = modNum<T>(5, 7) - modNum<T>(100, 1000);
+        REQUIRE(result.getValue() == 3);
+        REQUIRE(result.getMod() == 7);
+    }
+
+    SUBCASE("Default modulus")
+    {
+        modNum<T> result = modNum<T>() + modNum<T>(3, 7);
+        REQUIRE(result.getValue() == 0);
+        REQUIRE(result.getMod() == 1);
+        REQUIRE((modNum<T>() - modNum<T>(3, 7)).getValue() == 0);
+    }
+
+    SUBCASE("Long arithmetic")
+    {
+        using L = mpz_class;
+        modNum<L> sum = modNum<L>(5, 7) + modNum<L>(100, 1000);
+        REQUIRE(sum.getValue() == 0);
+        REQUIRE(sum.getMod() == 7);
+        modNum<L> difference = modNum<L>(5, 7) - modNum<L>(100, 1000);
+        REQUIRE(difference.getValue() == 3);
+        REQUIRE(difference.getMod() == 7);
+    }
+}
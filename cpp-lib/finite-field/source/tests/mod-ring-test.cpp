@@ -0,0 +1,99 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <gmpxx.h>
+#include <random>
+
+using namespace modular;
+
+TEST_CASE("Ring operations match modNum")
+{
+    using T = long long;
+    const T MOD = 1000003;
+    modRing<T> ring(MOD);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        modNum<T> a(getRandomNumber<T>(1, MOD - 1), MOD);
+        modNum<T> b(getRandomNumber<T>(1, MOD - 1), MOD);
+        T x = ring.fromModNum(a), y = ring.fromModNum(b);
+
+        REQUIRE(ring.toModNum(ring.add(x, y)) == a + b);
+        REQUIRE(ring.toModNum(ring.subs(x, y)) == a - b);
+        REQUIRE(ring.toModNum(ring.mult(x, y)) == a * b);
+        REQUIRE(ring.toModNum(ring.div(x, y)) == a / b);
+        REQUIRE(ring.toModNum(ring.pow(x, 12345)) == fpow(a, static_cast<T>(12345)));
+    }
+}
+
+TEST_CASE("Ring elements are bare residues")
+{
+    SUBCASE("Element normalisation")
+    {
+        modRing<int> ring(13);
+        CHECK_EQ(ring.element(-1), 12);
+        CHECK_EQ(ring.element(27), 1);
+    }
+
+    SUBCASE("Unsigned words near the type limit")
+    {
+        using T = uint64_t;
+        T mod = 18446744073709551557ULL;
+        modRing<T> ring(mod);
+        CHECK_EQ(ring.add(mod - 1, mod - 1), mod - 2);
+        CHECK_EQ(ring.subs(5, 7), mod - 2);
+        CHECK_EQ(ring.mult(mod - 1, mod - 1), static_cast<T>(1));
+    }
+
+    SUBCASE("Long arithmetic")
+    {
+        mpz_class mod;
+        mod.set_str("627917618844137493480783674921", 10);
+        modRing<mpz_class> ring(mod);
+        mpz_class x = ring.element(mpz_class(-2));
+        CHECK_EQ(ring.mult(x, x), mpz_class(4));
+        CHECK_EQ(ring.mult(x, ring.inv(x)), mpz_class(1));
+        // only word-sized rings keep a Barrett reducer
+        CHECK((std::is_same<reducerType<mpz_class>::type, noReducer>::value));
+        CHECK((std::is_same<reducerType<long long>::type, BarrettReducer>::value));
+    }
+
+    SUBCASE("Invalid modulus")
+    {
+        CHECK_THROWS_AS(modRing<int>(0), std::invalid_argument);
+        CHECK_THROWS_AS(modRing<int>(7).fromModNum(modNum<int>(1, 5)), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Element operations after validation")
+{
+    modRing<long long> ring(1000000007);
+    long long a = 0, b = 0;
+    static_assert(noexcept(ring.add(a, b)) && noexcept(ring.subs(a, b)) && noexcept(ring.mult(a, b)),
+                  "built-in ring operations should be noexcept");
+    static_assert(noexcept(ring.multAssign(a, b)), "built-in ring operations should be noexcept");
+
+    SUBCASE("Signed residues at the edges")
+    {
+        long long top = ring.getMod() - 1;
+        CHECK_EQ(ring.add(top, 1), 0);
+        CHECK_EQ(ring.add(top, top), top - 1);
+        CHECK_EQ(ring.subs(0, top), 1);
+        CHECK_EQ(ring.subs(top, 0), top);
+    }
+
+    SUBCASE("Matches modNum on random residues")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            long long x = getRandomNumber<long long>(0, 1000000006);
+            long long y = getRandomNumber<long long>(0, 1000000006);
+            modNum<long long> mx(x, ring.getMod()), my(y, ring.getMod());
+            CHECK(ring.toModNum(ring.add(x, y)) == mx + my);
+            CHECK(ring.toModNum(ring.subs(x, y)) == mx - my);
+            CHECK(ring.toModNum(ring.mult(x, y)) == mx * my);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <gmpxx.h>
+#include <random>
+
+using namespace modular;
+
+TEST_CASE("Montgomery context with built-in types")
+{
+    SUBCASE("Round trip and multiplication, long long")
+    {
+        using T = long long;
+        T mod = 1000000007;
+        MontgomeryContext<T> ctx(mod);
+        for (int i = 0; i < 1000; ++i)
+        {
+            T a = getRandomNumber(0, 1000000000);
+            T b = getRandomNumber(0, 1000000000);
+            T am = ctx.toMontgomery(a), bm = ctx.toMontgomery(b);
+
+            CHECK_EQ(ctx.fromMontgomery(am), a % mod);
+            CHECK_EQ(ctx.fromMontgomery(ctx.mult(am, bm)), (a * b) % mod);
+            CHECK_EQ(ctx.fromMontgomery(ctx.add(am, bm)), (a + b) % mod);
+            CHECK_EQ(ctx.fromMontgomery(ctx.subs(am, bm)), ((a - b) % mod + mod) % mod);
+        }
+    }
+
+    SUBCASE("Modulus close to the type limit, uint64_t")
+    {
+        using T = uint64_t;
+        T mod = 9223372036854775783ULL; // largest prime below 2^63
+        MontgomeryContext<T> ctx(mod);
+        T a = mod - 1, b = mod - 2;
+        T product = ctx.fromMontgomery(ctx.mult(ctx.toMontgomery(a), ctx.toMontgomery(b)));
+        CHECK_EQ(product, static_cast<T>(2));
+        CHECK_EQ(ctx.fromMontgomery(ctx.one()), static_cast<T>(1));
+    }
+
+    SUBCASE("Binding modNum")
+    {
+        modNum<int> a(17, 101), b(55, 101);
+        MontgomeryContext<int> ctx(101);
+        CHECK(ctx.toModNum(ctx.mult(ctx.fromModNum(a), ctx.fromModNum(b))) == a * b);
+        CHECK_THROWS_AS(ctx.fromModNum(modNum<int>(1, 103)), std::invalid_argument);
+    }
+
+    SUBCASE("Invalid modulus")
+    {
+        CHECK_THROWS_AS(MontgomeryContext<int>(100), std::invalid_argument);
+        CHECK_THROWS_AS(MontgomeryContext<int>(1), std::invalid_argument);
+        CHECK_THROWS_AS(MontgomeryContext<uint64_t>(18446744073709551557ULL), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Montgomery context with mpz_class")
+{
+    mpz_class mod, a, b;
+    mod.set_str("627917618844137493480783674921", 10);
+    a.set_str("1311790816646986218444823", 10);
+    b.set_str("84768435013152452201149402649", 10);
+
+    MontgomeryContext<mpz_class> ctx(mod);
+    mpz_class am = ctx.toMontgomery(a), bm = ctx.toMontgomery(b);
+
+    CHECK_EQ(ctx.fromMontgomery(am), a);
+    CHECK_EQ(ctx.fromMontgomery(ctx.mult(am, bm)), mpz_class(a * b % mod));
+    CHECK_EQ(ctx.fromMontgomery(ctx.subs(am, bm)), mpz_class(((a - b) % mod + mod) % mod));
+}
+
+TEST_CASE("Numbers bound to a Montgomery context")
+{
+    SUBCASE("Arithmetic matches modNum, uint64_t")
+    {
+        using T = uint64_t;
+        T mod = 9223372036854775783ULL;
+        MontgomeryContext<T> ctx(mod);
+        for (int i = 0; i < 1000; ++i)
+        {
+            modNum<T> a(getRandomNumber(0, 1000000000) * 9000000000ULL, mod);
+            modNum<T> b(getRandomNumber(1, 1000000000) * 9000000000ULL, mod);
+            montgomeryNum<T> am(ctx, a), bm(ctx, b);
+
+            CHECK(am.getValue() == a.getValue());
+            CHECK((am * bm).toModNum() == a * b);
+            CHECK((am + bm).toModNum() == a + b);
+            CHECK((am - bm).toModNum() == a - b);
+            CHECK((am / bm).toModNum() == a / b);
+        }
+    }
+
+    SUBCASE("In-place chain and power")
+    {
+        using T = long long;
+        T mod = 1000000007;
+        MontgomeryContext<T> ctx(mod);
+        montgomeryNum<T> x(ctx, 3), product(ctx, 1);
+        for (int i = 0; i < 100; ++i)
+            product *= x;
+        CHECK_EQ(product, fpow(x, 100LL));
+        CHECK_EQ(product.getValue(), fpow(modNum<T>(3, mod), 100LL).getValue());
+        CHECK_EQ(fpow(x, 0LL).getValue(), 1);
+        CHECK_EQ(fpow(x, mod - 1).getValue(), 1);
+        CHECK_THROWS_AS(fpow(montgomeryNum<T>(ctx, 0), 0LL), std::invalid_argument);
+        CHECK_THROWS_AS(montgomeryNum<T>(ctx, modNum<T>(1, 7)), std::invalid_argument);
+    }
+
+    SUBCASE("Long arithmetic")
+    {
+        mpz_class mod, a, b;
+        mod.set_str("627917618844137493480783674921", 10);
+        a.set_str("1311790816646986218444823", 10);
+        b.set_str("84768435013152452201149402649", 10);
+        MontgomeryContext<mpz_class> ctx(mod);
+        montgomeryNum<mpz_class> am(ctx, a), bm(ctx, b);
+
+        CHECK_EQ(am.getValue(), a);
+        CHECK((am * bm).toModNum() == modNum<mpz_class>(a, mod) * modNum<mpz_class>(b, mod));
+        CHECK((am / bm * bm) == am);
+        CHECK_EQ(fpow(am, mpz_class(mod - 1)).getValue(), 1);
+        CHECK_THROWS_AS(montgomeryNum<mpz_class>(ctx, 0).inv(), std::invalid_argument);
+    }
+}
@@ -0,0 +1,59 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <gmpxx.h>
+#include <utility>
+#include <vector>
+
+using namespace modular;
+
+TEST_CASE("Multi-exponentiation with built-in types")
+{
+    SUBCASE("Matches separate powers")
+    {
+        long long mod = 1000000007;
+        for (int i = 0; i < 200; ++i)
+        {
+            size_t count = getRandomNumber<size_t>(1, 5);
+            std::vector<std::pair<modNum<long long>, long long>> terms;
+            modNum<long long> expected(1, mod);
+            for (size_t t = 0; t < count; ++t)
+            {
+                modNum<long long> base(getRandomNumber<long long>(1, mod - 1), mod);
+                long long pw = getRandomNumber<long long>(0, 1000000000);
+                terms.emplace_back(base, pw);
+                expected *= fpow(base, pw);
+            }
+            CHECK(multiPow(terms) == expected);
+        }
+    }
+
+    SUBCASE("Exponents of different lengths and zero exponents")
+    {
+        uint64_t mod = 9223372036854775783ULL;
+        modNum<uint64_t> g(2, mod), h(3, mod);
+        std::vector<std::pair<modNum<uint64_t>, uint64_t>> terms = {{g, mod - 2}, {h, 5}, {g, 0}};
+        CHECK(multiPow(terms) == fpow(g, mod - 2) * fpow(h, static_cast<uint64_t>(5)));
+    }
+
+    SUBCASE("Invalid arguments")
+    {
+        std::vector<std::pair<modNum<int>, int>> empty;
+        CHECK_THROWS_AS(multiPow(empty), std::invalid_argument);
+        std::vector<std::pair<modNum<int>, int>> mixed = {{modNum<int>(2, 7), 1}, {modNum<int>(2, 11), 1}};
+        CHECK_THROWS_AS(multiPow(mixed), std::invalid_argument);
+        std::vector<std::pair<modNum<int>, int>> zero = {{modNum<int>(0, 7), 0}};
+        CHECK_THROWS_AS(multiPow(zero), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Multi-exponentiation with mpz_class")
+{
+    mpz_class mod("627917618844137493480783674921");
+    modNum<mpz_class> g(mpz_class("84768435013152452201149402649"), mod), h(mpz_class("1311790816646986218444823"), mod);
+    mpz_class a("3141592653589793238462643383279502884197"), b("2718281828459045235360287");
+    std::vector<std::pair<modNum<mpz_class>, mpz_class>> terms = {{g, a}, {h, b}};
+    CHECK(multiPow(terms) == fpow(g, a) * fpow(h, b));
+}
@@ -1,32 +1,39 @@
-// #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
-
-// #include "../../../doctest.h"
-// #include "../../mod-math.h"
-// #include <random>
-// #include "utils.h"
-
-// TEST_CASE("Naive tests")
-// {
-//     int num = 7;
-//     int mod = 31;
-
-//     int order = orderOfElement(modNum<int>(num, mod));
-
-//     CHECK(fpow(modNum<int>(num, mod), order).getValue() == 1);
-
-//     num = 9;
-//     order = orderOfElement(modNum<int>(num, mod));
-// }
-
-// TEST_CASE("Random tests")
-// {
-//     for (int i = 0; i < 1000; ++i)
-//     {
-//         int num = getRandomNumber(1, 10000);
-//         int mod = getRandomNumber(10000, 20000);
-
-//         int order = orderOfElement(modNum<int>(num, mod));
-
-//         CHECK(fpow(modNum<int>(num, mod), order).getValue() == 1);
-//     }
-// }
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+#include <random>
+#include "utils.h"
+
+using namespace modular;
+
+TEST_CASE("Naive tests")
+{
+    CHECK_EQ(orderOfElement(modNum<int>(7, 31)), 15);
+    CHECK_EQ(orderOfElement(modNum<int>(3, 31)), 30);
+    CHECK_EQ(orderOfElement(modNum<int>(1, 31)), 1);
+    CHECK_EQ(orderOfElement(modNum<int>(30, 31)), 2);
+    CHECK_EQ(orderOfElement(modNum<long long>(2, 1000000007)), 500000003);
+    CHECK_EQ(orderOfElement(modNum<long long>(5, 1000000007)), 1000000006);
+    CHECK_EQ(orderOfElement(modNum<mpz_class>(2, 1000000007)), 500000003);
+}
+
+TEST_CASE("Random tests")
+{
+    const int mods[] = {31, 9973, 65537, 999983};
+    for (int mod : mods)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            modNum<long long> a(getRandomNumber(1, mod - 1), mod);
+            long long order = orderOfElement(a);
+
+            CHECK_EQ((mod - 1) % order, 0);
+            CHECK(fpow(a, order).getValue() == 1);
+            // no proper divisor order / q is an order as well
+            for (auto [q, exponent] : cachedFactorization(static_cast<long long>(mod - 1)))
+                if (order % q == 0)
+                    CHECK(fpow(a, order / q).getValue() != 1);
+        }
+    }
+}
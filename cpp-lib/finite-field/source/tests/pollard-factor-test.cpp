@@ -113,4 +113,71 @@ TEST_CASE("Testing Pollard factorization")
 
         REQUIRE(a == mult);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Brent rho on large semiprimes")
+{
+    SUBCASE("Word-sized")
+    {
+        using T = long long;
+        T p = 2147483647, q = 1000000007;
+        T d = pollardRhO(p * q);
+        CHECK((d == p || d == q));
+
+        std::vector<T> factors = modNum<T>::Pollard<T>().factor(p * q * 2);
+        sort(factors.begin(), factors.end());
+        CHECK((factors == std::vector<T>{2, q, p}));
+    }
+
+    SUBCASE("GMP integers")
+    {
+        mpz_class p("4294967311"), q("1000000000039"), r("10000000000000061");
+        for (mpz_class n : {mpz_class(p * q), mpz_class(q * r), mpz_class(p * q * r * r)})
+        {
+
+            std::vector<mpz_class> factors = modNum<mpz_class>::Pollard<mpz_class>().factor(n);
+            mpz_class product = 1;
+            for (const mpz_class &f : factors)
+            {
+                CHECK(mpz_probab_prime_p(f.get_mpz_t(), 30) != 0);
+                product *= f;
+            }
+            CHECK_EQ(product, n);
+        }
+        mpz_class d = pollardRhO(mpz_class(q * r));
+        CHECK((d == q || d == r));
+    }
+
+    SUBCASE("Balanced 25-digit semiprime")
+    {
+        // n < 2^127 walks on 128-bit Montgomery products, about 10^6 steps here
+        mpz_class p("1000000000039"), q("3162277660169");
+        REQUIRE(isPrimeValue(p));
+        REQUIRE(isPrimeValue(q));
+        mpz_class d = pollardRhO(mpz_class(p * q));
+        std::vector<mpz_class> factors = modNum<mpz_class>::Pollard<mpz_class>().factor(p * q);
+        CHECK((d == p || d == q));
+        sort(factors.begin(), factors.end());
+        CHECK((factors == std::vector<mpz_class>{p, q}));
+    }
+
+    SUBCASE("factorize returns the factors in ascending order")
+    {
+        mpz_class n = mpz_class(1031) * mpz_class("4294967311") * mpz_class(1000000007) * mpz_class("10000000000000061");
+        std::vector<modNum<mpz_class>> factors = factorize(modNum<mpz_class>(n, n + 1));
+        std::vector<mpz_class> values;
+        for (const modNum<mpz_class> &f : factors)
+            values.push_back(f.getValue());
+        CHECK((values == std::vector<mpz_class>{mpz_class(1031), mpz_class(1000000007), mpz_class("4294967311"),
+                                                mpz_class("10000000000000061")}));
+    }
+
+    SUBCASE("Smooth p - 1 is split before rho")
+    {
+        // p - 1 = 13 * 2 * 3 * ... * 47 * 9973, far too large a prime for rho alone
+        mpz_class p("79719845422815322815091"), q("1000000000000000000000000000057");
+        std::vector<mpz_class> factors = modNum<mpz_class>::Pollard<mpz_class>().factor(p * q);
+        sort(factors.begin(), factors.end());
+        CHECK((factors == std::vector<mpz_class>{p, q}));
+    }
+}
@@ -0,0 +1,112 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <algorithm>
+#include <vector>
+
+using namespace modular;
+
+// smallest prime p = smooth * t + sign with t >= 1, so p - sign is smooth * t
+mpz_class primeNear(const mpz_class &smooth, int sign)
+{
+    for (mpz_class t = 1;; ++t)
+    {
+        mpz_class p = smooth * t + sign;
+        if (mpz_probab_prime_p(p.get_mpz_t(), 30))
+            return p;
+    }
+}
+
+mpz_class smoothProduct(std::initializer_list<unsigned long> primes)
+{
+    mpz_class product = 1;
+    for (unsigned long p : primes)
+        product *= p;
+    return product;
+}
+
+TEST_CASE("Lucas sequences")
+{
+    mpz_class n("1000000000000000000000007"), x = 7, result, inner;
+    // V_0 = 2, V_1 = x, V_(k+1) = x V_k - V_(k-1)
+    mpz_class previous = 2, current = x;
+    for (uint64_t k = 1; k <= 40; ++k)
+    {
+        lucasV(result, x, k, n);
+        CHECK_EQ(result, current);
+        mpz_class next = (x * current - previous) % n;
+        if (next < 0)
+            next += n;
+        previous = current;
+        current = next;
+    }
+    // V_6(V_5(x)) = V_30(x)
+    lucasV(inner, x, 5, n);
+    lucasV(inner, inner, 6, n);
+    lucasV(result, x, 30, n);
+    CHECK_EQ(inner, result);
+}
+
+TEST_CASE("Pollard p - 1")
+{
+    std::vector<uint64_t> primes = primesUpTo(1000000);
+    CHECK_EQ(primes.size(), 78498);
+    mpz_class q("1000000000000000000000000000057");
+
+    SUBCASE("Stage 1")
+    {
+        mpz_class p = primeNear(smoothProduct({2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 9973}), 1);
+        CHECK_EQ(pm1FindFactor(p * q, primes, 10000, 10000), p);
+    }
+
+    SUBCASE("Stage 2")
+    {
+        mpz_class p = primeNear(smoothProduct({2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 999983}), 1);
+        CHECK_EQ(pm1FindFactor(p * q, primes, 10000, 10000), 1);
+        CHECK_EQ(pm1FindFactor(p * q, primes, 10000, 1000000), p);
+    }
+
+    SUBCASE("Prime bounds")
+    {
+        CHECK((primesUpTo(7) == std::vector<uint64_t>{2, 3, 5, 7}));
+        // p - 1 = 2 * 1000151, so a prime bound equal to 1000151 has to reach it
+        mpz_class p = 2 * 1000151 + 1;
+        std::vector<uint64_t> bounded = primesUpTo(1000151);
+        CHECK_EQ(bounded.back(), 1000151);
+        CHECK_EQ(pm1FindFactor(p * q, bounded, 1000151, 1000151), p);
+    }
+
+    SUBCASE("Strategy")
+    {
+        mpz_class p = primeNear(smoothProduct({2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59}), 1);
+        mpz_class r = primeNear(smoothProduct({2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 61, 67}), 1);
+        std::vector<mpz_class> factors = modNum<mpz_class>::PMinus1<mpz_class>(10000).factor(p * q * r * 6);
+        std::sort(factors.begin(), factors.end());
+        std::vector<mpz_class> expected = {2, 3, p, r, q};
+        std::sort(expected.begin(), expected.end());
+        CHECK((factors == expected));
+
+        std::vector<long long> words = modNum<long long>::PMinus1<long long>(1000).factor(1000000007LL * 999999937LL);
+        std::sort(words.begin(), words.end());
+        CHECK((words == std::vector<long long>{999999937LL, 1000000007LL}));
+    }
+}
+
+TEST_CASE("Williams p + 1")
+{
+    std::vector<uint64_t> primes = primesUpTo(1000000);
+    mpz_class q("1000000000000000000000000000057");
+    mpz_class p = primeNear(smoothProduct({2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 99991}), -1);
+    mpz_class n = p * q;
+
+    // p - 1 is not smooth, so only p + 1 finds p
+    CHECK_EQ(pm1FindFactor(n, primes, 10000, 1000000), 1);
+    CHECK_EQ(pp1Seeds(n, primes, 10000, 1000000), p);
+
+    std::vector<modNum<mpz_class>> factors = pp1Factorize(modNum<mpz_class>(n, n + 1), 10000);
+    CHECK_EQ(factors.size(), 2);
+    CHECK_EQ(factors[0].getValue() * factors[1].getValue(), n);
+    CHECK_THROWS_AS(pm1Factorize(modNum<mpz_class>(0, 7)), std::invalid_argument);
+}
@@ -0,0 +1,111 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <climits>
+#include <vector>
+
+using namespace modular;
+
+TEST_CASE("Next and previous prime")
+{
+    SUBCASE("Built-in types")
+    {
+        CHECK_EQ(nextPrime(-10LL), 2);
+        CHECK_EQ(nextPrime(2LL), 3);
+        CHECK_EQ(nextPrime(1000000000LL), 1000000007LL);
+        CHECK_EQ(nextPrime(370261LL), 370373LL);
+        CHECK_EQ(prevPrime(3LL), 2);
+        CHECK_EQ(prevPrime(1000000007LL), 999999937LL);
+        CHECK_EQ(prevPrime(370373LL), 370261LL);
+
+        CHECK_EQ(nextPrime(9223372036854775782LL), 9223372036854775783LL);
+        CHECK_THROWS_AS(nextPrime(9223372036854775783LL), std::invalid_argument);
+        CHECK_EQ(prevPrime(ULLONG_MAX), 18446744073709551557ULL);
+        CHECK_THROWS_AS(nextPrime(18446744073709551557ULL), std::invalid_argument);
+        CHECK_EQ(nextPrime(4294967290u), 4294967291u);
+        CHECK_THROWS_AS(nextPrime(4294967291u), std::invalid_argument);
+        CHECK_THROWS_AS(prevPrime(2), std::invalid_argument);
+
+        for (int n = 0; n < 5000; ++n)
+        {
+            int next = nextPrime(n);
+            CHECK(isPrime(modNum<int>(next, next + 1), 1));
+            for (int m = n + 1; m < next; ++m)
+                CHECK_FALSE(isPrime(modNum<int>(m, m + 1), 1));
+            if (n > 2)
+            {
+                int prev = prevPrime(n);
+                CHECK(isPrime(modNum<int>(prev, prev + 1), 1));
+                CHECK_GE(nextPrime(prev), n);
+            }
+        }
+    }
+
+    SUBCASE("GMP integers")
+    {
+        mpz_class pow2 = mpz_class(1) << 127;
+        mpz_class mersenne = pow2 - 1;
+        CHECK_EQ(prevPrime(mpz_class(mersenne + 1)), mersenne);
+        CHECK_EQ(nextPrime(mpz_class(mersenne - 1)), mersenne);
+
+        mpz_class n("1000000000000000000000000000000"), expected;
+        mpz_nextprime(expected.get_mpz_t(), n.get_mpz_t());
+        CHECK_EQ(nextPrime(n), expected);
+        CHECK_EQ(prevPrime(mpz_class(expected + 1)), expected);
+    }
+}
+
+TEST_CASE("Random primes")
+{
+    setRandomSeed(99);
+    for (size_t bits : {2, 3, 10, 31, 62})
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            long long p = randomPrime<long long>(bits);
+            CHECK(isPrime(modNum<long long>(p, p + 1), 1));
+            CHECK_EQ(exponentBitLength(p), bits);
+        }
+    }
+    mpz_class big = randomPrime<mpz_class>(512);
+    CHECK_EQ(mpz_sizeinbase(big.get_mpz_t(), 2), 512);
+    CHECK(mpz_probab_prime_p(big.get_mpz_t(), 30) != 0);
+
+    CHECK_THROWS_AS(randomPrime<long long>(1), std::invalid_argument);
+    CHECK_THROWS_AS(randomPrime<long long>(64), std::invalid_argument);
+    CHECK_EQ(exponentBitLength(randomPrime<unsigned long long>(64)), 64);
+}
+
+TEST_CASE("Batch primality")
+{
+    SUBCASE("Intervals")
+    {
+        for (size_t threads : {1, 3})
+        {
+            std::vector<bool> bitmap = primeBitmap(-20LL, 20000LL, threads);
+            CHECK_EQ(bitmap.size(), 20020);
+            for (long long n = -20; n < 20000; ++n)
+                CHECK_EQ(bitmap[n + 20], n > 1 && isPrime(modNum<long long>(n, n + 1), 1));
+        }
+
+        mpz_class lo = mpz_class(1) << 100;
+        std::vector<bool> bitmap = primeBitmap(lo, mpz_class(lo + 3000));
+        for (size_t i = 0; i < bitmap.size(); ++i)
+        {
+            mpz_class n = lo + i;
+            CHECK_EQ(bitmap[i], mpz_probab_prime_p(n.get_mpz_t(), 30) != 0);
+        }
+        CHECK(primeBitmap(5, 5).empty());
+    }
+
+    SUBCASE("Lists")
+    {
+        std::vector<unsigned long long> values = {0, 1, 2, 561, 1000000007ULL, 18446744073709551557ULL,
+                                                  3825123056546413051ULL};
+        std::vector<bool> expected = {false, false, true, false, true, true, false};
+        CHECK(isPrimeBatch(values, 2) == expected);
+        CHECK(isPrimeBatch(std::vector<int>{}).empty());
+    }
+}
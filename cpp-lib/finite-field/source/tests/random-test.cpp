@@ -0,0 +1,132 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <chrono>
+#include <climits>
+#include <thread>
+#include <vector>
+
+using namespace modular;
+
+TEST_CASE("xoshiro256++ generator")
+{
+    SUBCASE("Same seed, same sequence")
+    {
+        randomGenerator a(12345), b(12345), c(54321);
+        bool differs = false;
+        for (int i = 0; i < 100; ++i)
+        {
+            uint64_t x = a();
+            CHECK_EQ(x, b());
+            differs |= x != c();
+        }
+        CHECK(differs);
+    }
+
+    SUBCASE("Reseeding restarts the sequence")
+    {
+        randomGenerator generator(7);
+        uint64_t first = generator();
+        generator();
+        generator.seed(7);
+        CHECK_EQ(generator(), first);
+    }
+}
+
+TEST_CASE("Thread generators")
+{
+    setRandomSeed(2024);
+    std::vector<long long> first;
+    for (int i = 0; i < 10; ++i)
+        first.push_back(randomBelow(1000000LL));
+    setRandomSeed(2024);
+    for (int i = 0; i < 10; ++i)
+        CHECK_EQ(randomBelow(1000000LL), first[i]);
+
+    // a worker seeded with the same value reproduces the sequence of the caller
+    std::vector<long long> second;
+    std::thread worker([&second]
+                       {
+                           threadRandom().seed(2024);
+                           for (int i = 0; i < 10; ++i)
+                               second.push_back(randomBelow(1000000LL));
+                       });
+    worker.join();
+    CHECK(second == first);
+}
+
+TEST_CASE("Worker pool generators")
+{
+    // every chunk draws from its own stream, whichever thread runs it and whenever it starts
+    auto draw = [](bool reversed)
+    {
+        std::vector<long long> values(64);
+        parallelFor(values.size(), 4,
+                    [&values, reversed](size_t begin, size_t end)
+                    {
+                        size_t delay = reversed ? values.size() - begin : begin;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+                        for (size_t i = begin; i < end; ++i)
+                            values[i] = randomBelow(1000000000LL);
+                    });
+        values.push_back(randomBelow(1000000000LL));
+        return values;
+    };
+
+    setRandomSeed(77);
+    std::vector<long long> first = draw(false);
+    setRandomSeed(77);
+    CHECK(draw(true) == first);
+    CHECK(first[0] != first[16]);
+    setRandomSeed(78);
+    CHECK(draw(false) != first);
+}
+
+TEST_CASE("Uniform sampling")
+{
+    setRandomSeed(1);
+
+    SUBCASE("Built-in types")
+    {
+        std::vector<int> counts(10);
+        for (int i = 0; i < 100000; ++i)
+            counts[randomBelow(10)]++;
+        for (int count : counts)
+            CHECK((count > 9500 && count < 10500));
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            long long x = randomRange(-5LL, 5LL);
+            CHECK((x >= -5 && x <= 5));
+            unsigned long long y = randomBelow(3ULL);
+            CHECK(y < 3);
+        }
+        randomRange(LLONG_MIN, LLONG_MAX);
+        CHECK_EQ(randomRange(42, 42), 42);
+        CHECK_THROWS_AS(randomBelow(0), std::invalid_argument);
+        CHECK_THROWS_AS(randomRange(2, 1), std::invalid_argument);
+    }
+
+    SUBCASE("GMP integers")
+    {
+        mpz_class bound("100000000000000000000000000000000000000000007"), low = -bound;
+        mpz_class half = bound / 2;
+        int upper = 0;
+        for (int i = 0; i < 2000; ++i)
+        {
+            mpz_class x = randomBelow(bound);
+            CHECK((x >= 0 && x < bound));
+            upper += x >= half;
+            mpz_class y = randomRange(low, bound);
+            CHECK((y >= low && y <= bound));
+        }
+        CHECK((upper > 900 && upper < 1100));
+
+        mpz_class pow2 = mpz_class(1) << 128;
+        for (int i = 0; i < 100; ++i)
+            CHECK(randomBelow(pow2) < pow2);
+        CHECK_EQ(randomBelow(mpz_class(1)), 0);
+    }
+}
@@ -0,0 +1,130 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <map>
+#include <vector>
+
+using namespace modular;
+
+std::vector<uint64_t> trialPrimes(uint64_t lo, uint64_t hi)
+{
+    std::vector<uint64_t> primes;
+    for (uint64_t n = lo; n < hi; ++n)
+    {
+        bool prime = n >= 2;
+        for (uint64_t d = 2; d * d <= n && prime; ++d)
+            prime = n % d != 0;
+        if (prime)
+            primes.push_back(n);
+    }
+    return primes;
+}
+
+TEST_CASE("Segmented sieve")
+{
+    SUBCASE("Ranges against trial division")
+    {
+        for (auto bounds : std::vector<std::pair<uint64_t, uint64_t>>{
+                 {0, 0}, {0, 2}, {0, 3}, {2, 3}, {3, 4}, {0, 100}, {1, 10000}, {9973, 9974},
+                 {1000000, 1010000}, {4294967000ULL, 4294968000ULL}, {68719476736ULL, 68719478736ULL},
+                 {100, 50}})
+        {
+            std::vector<uint64_t> expected = trialPrimes(bounds.first, std::max(bounds.first, bounds.second));
+            for (size_t block : {1, 7, 64, 32768})
+            {
+                primeRange range(bounds.first, bounds.second, block);
+                std::vector<uint64_t> found(range.begin(), range.end());
+                CHECK(found == expected);
+            }
+        }
+    }
+
+    SUBCASE("Restarting the enumeration")
+    {
+        primeRange range(10, 60, 4);
+        std::vector<uint64_t> first(range.begin(), range.end());
+        std::vector<uint64_t> second(range.begin(), range.end());
+        CHECK(first == second);
+        CHECK_EQ(first.size(), 13);
+    }
+
+    SUBCASE("Near the upper limit")
+    {
+        // base primes above 2^16 are sieved per window, so a large bound costs no memory up front
+        uint64_t hi = UINT64_MAX - (1ULL << 33);
+        primeRange top(hi - 2000, hi, 256);
+        uint64_t near = 1ULL << 48;
+        primeRange range(near - 2000, near, 256);
+        size_t count = 0;
+        for (uint64_t p : range)
+        {
+            CHECK(isPrime(modNum<unsigned long long>(p, UINT64_MAX), 1));
+            ++count;
+        }
+        CHECK_EQ(count, 62);
+        CHECK_THROWS_AS(primeRange(0, hi + 1), std::invalid_argument);
+        CHECK_THROWS_AS(primeRange(0, 10, 0), std::invalid_argument);
+    }
+
+    SUBCASE("Wide window with a large base")
+    {
+        // the base primes up to 2^28 are sieved once for all 16 blocks of the window
+        uint64_t low = 1ULL << 56, high = low + 1000000;
+        primeRange range(low, high);
+        size_t count = 0;
+        uint64_t previous = low;
+        for (uint64_t p : range)
+        {
+            for (uint64_t n = previous | 1; n < p; n += 2)
+                CHECK_FALSE(isPrimeValue(n));
+            CHECK(isPrimeValue(p));
+            previous = p + 1;
+            ++count;
+        }
+        CHECK_EQ(count, 25764);
+    }
+}
+
+TEST_CASE("Prime counting")
+{
+    uint64_t expected[] = {0, 4, 25, 168, 1229, 9592, 78498, 664579, 5761455, 50847534, 455052511};
+    uint64_t n = 1;
+    for (uint64_t count : expected)
+    {
+        CHECK_EQ(primeCount(n), count);
+        n *= 10;
+    }
+    CHECK_EQ(primeCount(0), 0);
+    CHECK_EQ(primeCount(2), 1);
+    CHECK_EQ(primeCount(1000000000000ULL), 37607912018ULL);
+
+    primeRange range(0, 123457);
+    CHECK_EQ(static_cast<uint64_t>(std::distance(range.begin(), range.end())), primeCount(123456));
+}
+
+TEST_CASE("Prime factorization over the sieve")
+{
+    using factorMap = std::map<long long, unsigned>;
+    auto factorsOf = [](long long n)
+    {
+        factorMap found;
+        forEachPrimeFactor(n, [&found](long long p, unsigned exponent) { found[p] += exponent; });
+        return found;
+    };
+
+    CHECK((factorsOf(1) == factorMap{}));
+    CHECK((factorsOf(1031LL * 1031 * 1033) == factorMap{{1031, 2}, {1033, 1}}));
+    CHECK((factorsOf(8LL * 1000003 * 1000033) == factorMap{{2, 3}, {1000003, 1}, {1000033, 1}}));
+    CHECK((factorsOf(999999000001LL) == factorMap{{999999000001LL, 1}}));
+
+    auto mpzFactors = [](const mpz_class &n)
+    {
+        std::vector<mpz_class> found;
+        forEachPrimeFactor(n, [&found](const mpz_class &p, unsigned exponent)
+                           { found.insert(found.end(), exponent, p); });
+        return found;
+    };
+    CHECK((mpzFactors(mpz_class(1031 * 1031) * 3) == std::vector<mpz_class>{3, 1031, 1031}));
+}
@@ -0,0 +1,99 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <random>
+#include <vector>
+
+using namespace modular;
+
+template <typename T>
+std::vector<T> randomResidues(size_t size, T mod, std::mt19937_64 &gen)
+{
+    std::vector<T> values(size);
+    for (T &value : values)
+        value = static_cast<T>(gen() % mod);
+    return values;
+}
+
+template <typename T>
+void checkKernels(T mod, size_t size, std::mt19937_64 &gen)
+{
+    std::vector<T> a = randomResidues(size, mod, gen), b = randomResidues(size, mod, gen),
+                   c = randomResidues(size, mod, gen);
+    T scalar = static_cast<T>(gen() % mod);
+
+    std::vector<T> sum(size), diff(size), prod(size), fused(size), scaled(size);
+    T dot = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        using wide = unsigned __int128;
+        wide x = a[i], y = b[i], z = c[i];
+        sum[i] = static_cast<T>((x + y) % mod);
+        diff[i] = static_cast<T>((x + mod - y) % mod);
+        prod[i] = static_cast<T>(x * y % mod);
+        fused[i] = static_cast<T>((x * y + z) % mod);
+        scaled[i] = static_cast<T>(x * scalar % mod);
+        dot = static_cast<T>((x * y + dot) % mod);
+    }
+
+    for (simdLevel level : {simdLevel::scalar, simdLevel::avx2, simdLevel::avx512})
+    {
+        setSimdLevel(level);
+        std::vector<T> result(size);
+
+        bulkAdd(result.data(), a.data(), b.data(), size, mod);
+        CHECK(result == sum);
+        bulkSubs(result.data(), a.data(), b.data(), size, mod);
+        CHECK(result == diff);
+        bulkMult(result.data(), a.data(), b.data(), size, mod);
+        CHECK(result == prod);
+        bulkMultAdd(result.data(), a.data(), b.data(), c.data(), size, mod);
+        CHECK(result == fused);
+        bulkScale(result.data(), a.data(), scalar, size, mod);
+        CHECK(result == scaled);
+        CHECK_EQ(bulkDot(a.data(), b.data(), size, mod), dot);
+
+        // result aliasing the first input
+        result = a;
+        bulkMult(result.data(), result.data(), b.data(), size, mod);
+        CHECK(result == prod);
+    }
+    setSimdLevel(simdLevel::avx512);
+}
+
+TEST_CASE("Bulk kernels on 32-bit residues")
+{
+    std::mt19937_64 gen(42);
+
+    SUBCASE("Odd moduli")
+    {
+        for (uint32_t mod : {3u, 998244353u, 1000000007u, 2147483647u})
+            for (size_t size : {0, 1, 7, 8, 17, 100, 1025})
+                checkKernels<uint32_t>(mod, size, gen);
+    }
+
+    SUBCASE("Even and large moduli fall back to scalar")
+    {
+        for (uint32_t mod : {2u, 1000000u, 4294967291u})
+            checkKernels<uint32_t>(mod, 50, gen);
+    }
+}
+
+TEST_CASE("Bulk kernels on 64-bit residues")
+{
+    std::mt19937_64 gen(7);
+    for (uint64_t mod : {5ULL, 1000000007ULL, 4611686018427387847ULL, 9223372036854775783ULL,
+                         18446744073709551557ULL})
+        for (size_t size : {0, 3, 8, 33, 500})
+            checkKernels<uint64_t>(mod, size, gen);
+}
+
+TEST_CASE("Simd level is capped by the CPU")
+{
+    setSimdLevel(simdLevel::scalar);
+    CHECK(getSimdLevel() == simdLevel::scalar);
+    setSimdLevel(simdLevel::avx512);
+    CHECK(getSimdLevel() == detectSimdLevel());
+}
@@ -0,0 +1,80 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <algorithm>
+#include <vector>
+
+using namespace modular;
+
+mpz_class primeAbove(const char *start)
+{
+    mpz_class p(start);
+    mpz_nextprime(p.get_mpz_t(), p.get_mpz_t());
+    return p;
+}
+
+TEST_CASE("SIQS parameters")
+{
+    siqsParameters small = siqsChooseParameters(10), middle = siqsChooseParameters(55),
+                   large = siqsChooseParameters(200);
+    CHECK_EQ(small.digits, 20);
+    CHECK((middle.primes > siqsChooseParameters(50).primes && middle.primes < siqsChooseParameters(60).primes));
+    CHECK_EQ(middle.halfWidth % siqsBlockSize, 0);
+    CHECK_EQ(large.digits, siqsMaxDigits);
+    siqsParameters wide = siqsChooseParameters(85);
+    CHECK((wide.primes > siqsChooseParameters(80).primes && wide.primes < siqsChooseParameters(90).primes));
+
+    unsigned k = siqsMultiplier(mpz_class("1000000000000000000000000000000000000001"));
+    CHECK((k % 2 == 1 && k < 75));
+}
+
+TEST_CASE("SIQS factorization")
+{
+    setRandomSeed(11);
+
+    SUBCASE("Balanced semiprimes")
+    {
+        for (const char *digits : {"100000000000000", "10000000000000000000", "1000000000000000000000"})
+        {
+            mpz_class p = primeAbove(digits), q = primeAbove(mpz_class(mpz_class(digits) * 7 + 3).get_str().c_str());
+            mpz_class n = p * q;
+            mpz_class factor = siqsFindFactor(n, 0);
+            CHECK((factor == p || factor == q));
+        }
+    }
+
+    SUBCASE("Single thread")
+    {
+        mpz_class p = primeAbove("3000000000000000000"), q = primeAbove("5000000000000000000000");
+        mpz_class factor = siqsFindFactor(p * q, 1);
+        CHECK((factor == p || factor == q));
+    }
+
+    SUBCASE("Strategy")
+    {
+        mpz_class p = primeAbove("100000000000000000"), q = primeAbove("200000000000000000000"),
+                  r = primeAbove("1000000007");
+        std::vector<mpz_class> factors = modNum<mpz_class>::SIQS<mpz_class>().factor(p * q * r * r * 12);
+        std::sort(factors.begin(), factors.end());
+        CHECK((factors == std::vector<mpz_class>{2, 2, 3, r, r, p, q}));
+
+        mpz_class cube = q * q * q;
+        factors = modNum<mpz_class>::SIQS<mpz_class>(2).factor(cube);
+        CHECK((factors == std::vector<mpz_class>{q, q, q}));
+
+        std::vector<long long> words = modNum<long long>::SIQS<long long>().factor(1000000007LL * 999999937LL);
+        std::sort(words.begin(), words.end());
+        CHECK((words == std::vector<long long>{999999937LL, 1000000007LL}));
+    }
+
+    SUBCASE("Through modNum")
+    {
+        mpz_class n = primeAbove("10000000000000000000") * primeAbove("30000000000000000000");
+        std::vector<modNum<mpz_class>> factors = siqsFactorize(modNum<mpz_class>(n, n + 1), 2);
+        CHECK_EQ(factors.size(), 2);
+        CHECK_EQ(factors[0].getValue() * factors[1].getValue(), n);
+        CHECK_THROWS_AS(siqsFactorize(modNum<mpz_class>(0, 7)), std::invalid_argument);
+    }
+}
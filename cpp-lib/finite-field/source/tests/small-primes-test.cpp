@@ -0,0 +1,100 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../doctest.h"
+#include "../../mod-math.h"
+
+#include "utils.h"
+#include <map>
+#include <vector>
+
+using namespace modular;
+
+bool trialIsPrime(uint64_t n)
+{
+    if (n < 2)
+        return false;
+    for (uint64_t d = 2; d * d <= n; ++d)
+        if (n % d == 0)
+            return false;
+    return true;
+}
+
+TEST_CASE("Compile-time small-prime table")
+{
+    static_assert(smallPrimeTable.size() == 172, "primes below 1024");
+    static_assert(smallPrimeTable[0].prime == 2 && smallPrimeTable[171].prime == 1021, "table bounds");
+
+    for (const smallPrime &entry : smallPrimeTable)
+    {
+        CHECK(trialIsPrime(entry.prime));
+        if (entry.prime != 2)
+            CHECK_EQ(entry.prime * entry.inverse, 1ULL);
+    }
+}
+
+TEST_CASE("Small-prime filter")
+{
+    SUBCASE("Decided below the square of the bound")
+    {
+        for (uint64_t n = 0; n < 1048576; n += (n < 5000 ? 1 : 97))
+        {
+            sieveVerdict expected = trialIsPrime(n) ? sieveVerdict::prime : sieveVerdict::composite;
+            CHECK(smallPrimeFilter(n) == expected);
+            CHECK(smallPrimeFilter(static_cast<long long>(n)) == expected);
+            CHECK(smallPrimeFilter(mpz_class(static_cast<unsigned long>(n))) == expected);
+        }
+    }
+
+    SUBCASE("Large values")
+    {
+        CHECK(smallPrimeFilter(1000000007ULL * 1000000009ULL) == sieveVerdict::unknown);
+        CHECK(smallPrimeFilter(1000000007ULL * 1021ULL) == sieveVerdict::composite);
+        mpz_class big("340282366920938463463374607431768211507");
+        CHECK(smallPrimeFilter(big) == sieveVerdict::unknown);
+        CHECK(smallPrimeFilter(mpz_class(big * 1019)) == sieveVerdict::composite);
+        CHECK(smallPrimeFilter(-7LL) == sieveVerdict::composite);
+    }
+}
+
+TEST_CASE("Stripping small prime factors")
+{
+    using factorMap = std::map<long long, unsigned>;
+    factorMap found;
+    auto collect = [&found](long long p, unsigned exponent) { found[p] += exponent; };
+
+    CHECK_EQ(stripSmallPrimes(2LL * 2 * 2 * 3 * 1021 * 1021, collect), 1);
+    CHECK((found == factorMap{{2, 3}, {3, 1}, {1021, 2}}));
+
+    found.clear();
+    CHECK_EQ(stripSmallPrimes(6LL * 1000000007LL, collect), 1000000007LL);
+    CHECK((found == factorMap{{2, 1}, {3, 1}}));
+
+    found.clear();
+    CHECK_EQ(stripSmallPrimes(2LL * 997, collect), 1);
+    CHECK((found == factorMap{{2, 1}, {997, 1}}));
+}
+
+TEST_CASE("Euler and Carmichael functions after the table")
+{
+    for (long long n = 1; n < 3000; ++n)
+    {
+        long long phi = 0;
+        for (long long k = 1; k <= n; ++k)
+            phi += mygcd(k, n) == 1;
+        CHECK_EQ(EulerFunction(n), phi);
+
+        long long lambda = 1;
+        while (true)
+        {
+            bool ok = true;
+            for (long long k = 1; k < n && ok; ++k)
+                if (mygcd(k, n) == 1 && fpow(modNum<long long>(k, n), lambda).getValue() != 1)
+                    ok = false;
+            if (ok)
+                break;
+            lambda++;
+        }
+        CHECK_EQ(CarmichaelFunction(n), lambda);
+    }
+    CHECK_EQ(EulerFunction(1031LL * 1033LL), 1030LL * 1032LL);
+    CHECK_EQ(CarmichaelFunction(1031LL * 1031LL * 8), 1031LL * 1030LL);
+}
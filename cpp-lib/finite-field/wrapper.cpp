@@ -147,27 +147,32 @@ division(char *a, char *b, char *mod, char *errorStr)
 }
 
 /*
- *    @brief Calculates the remainder of a and b modulo mod
- *    @param a The first number
- *    @param b The second number
+ *    @brief Calculates a to the power of degree modulo mod
+ *    @param a The base
+ *    @param degree The power
  *    @param mod The modulus of the operation
- *    @return A char pointer to the result of the remainder in string form
+ *    @param engine 0 - classic, 1 - Montgomery, 2 - automatic
+ *    @return A char pointer to the result in string form
  *    @note memory should be manualy freed by delete[]
  *
  */
 
 extern "C" char *
-fastPow(char *a, char *degree, char *mod, char *errorStr)
+fastPowEngine(char *a, char *degree, char *mod, int engine, char *errorStr)
 {
     char *resStr = nullptr;
     try
     {
+        if (engine < static_cast<int>(powEngine::classic) || engine > static_cast<int>(powEngine::automatic))
+        {
+            throw std::invalid_argument("Unknown exponentiation engine");
+        }
         mpz_class numA, numDegree, numMod;
         numA.set_str(a, 10), numDegree.set_str(degree, 10), numMod.set_str(mod, 10);
 
         modNum<mpz_class> a1(numA, numMod), res;
 
-        res = fpow(a1, numDegree);
+        res = fpow(a1, numDegree, static_cast<powEngine>(engine));
         char *resStr = new char[MESSAGE_LEN];
         strcpy(resStr, res.getValue().get_str().c_str());
         return resStr;
@@ -180,6 +185,22 @@ fastPow(char *a, char *degree, char *mod, char *errorStr)
     return resStr;
 }
 
+/*
+ *    @brief Calculates a to the power of degree modulo mod with the automatically chosen engine
+ *    @param a The base
+ *    @param degree The power
+ *    @param mod The modulus of the operation
+ *    @return A char pointer to the result in string form
+ *    @note memory should be manualy freed by delete[]
+ *
+ */
+
+extern "C" char *
+fastPow(char *a, char *degree, char *mod, char *errorStr)
+{
+    return fastPowEngine(a, degree, mod, static_cast<int>(powEngine::automatic), errorStr);
+}
+
 /*
  *    @brief Calculates the remainder of a and b modulo mod
  *    @param a The first number
@@ -214,6 +235,129 @@ inverse(char *num, char *mod, char *errorStr)
     return resStr;
 }
 
+/**
+ *
+ *    @brief Inverts many numbers modulo one modulus with a single modular inversion.
+ *    @param size Reference to a variable that will hold the length of the result string.
+ *    @param nums Array of numbers to invert.
+ *    @param count The number of elements in nums.
+ *    @param mod The modulus.
+ *    @return A string of space separated inverses in the order of nums, "-" stands for a
+ * number that has no inverse.
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+batchInversion(size_t &size, char **nums, size_t count, char *mod, char *errorStr)
+{
+    try
+    {
+        mpz_class numMod;
+        numMod.set_str(mod, 10);
+
+        std::vector<mpz_class> values(count);
+        for (size_t i = 0; i < count; ++i)
+            values[i].set_str(nums[i], 10);
+
+        std::vector<bool> invertible = modular::batchInverse(values, numMod);
+
+        std::string strCombined;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            strCombined += invertible[i] ? values[i].get_str() : "-";
+            strCombined += " ";
+        }
+
+        char *resStr = new char[strCombined.size() + 1];
+        strcpy(resStr, strCombined.c_str());
+
+        size = strCombined.size();
+
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+
+/**
+ *
+ *    @brief Raises many numbers to powers modulo one modulus.
+ *    The modulus is parsed once, moduli that fit a long are handled with built-in integers.
+ *    @param size Reference to a variable that will hold the length of the result string.
+ *    @param nums Array of bases.
+ *    @param degrees Array of powers, one per base, or a single power shared by all bases.
+ *    @param count The number of elements in nums.
+ *    @param degreeCount The number of elements in degrees, 1 or count.
+ *    @param mod The modulus.
+ *    @param threads The number of worker threads, 0 for one per hardware thread.
+ *    @return A string of space separated results in the order of nums.
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+batchPower(size_t &size, char **nums, char **degrees, size_t count, size_t degreeCount, char *mod, size_t threads,
+           char *errorStr)
+{
+    try
+    {
+        mpz_class numMod;
+        numMod.set_str(mod, 10);
+
+        std::vector<mpz_class> values(count), powers(degreeCount);
+        for (size_t i = 0; i < count; ++i)
+            values[i].set_str(nums[i], 10);
+        for (size_t i = 0; i < degreeCount; ++i)
+            powers[i].set_str(degrees[i], 10);
+
+        std::string strCombined;
+        bool wordSize = numMod > 0 && numMod.fits_slong_p();
+        for (const mpz_class &power : powers)
+            wordSize = wordSize && power >= 0 && power.fits_slong_p();
+
+        if (wordSize)
+        {
+            long long wordMod = numMod.get_si();
+            std::vector<long long> wordValues(count), wordPowers(degreeCount);
+            for (size_t i = 0; i < count; ++i)
+                wordValues[i] = mpz_class(values[i] % numMod).get_si();
+            for (size_t i = 0; i < degreeCount; ++i)
+                wordPowers[i] = powers[i].get_si();
+
+            for (long long result : modular::batchPow(wordValues, wordPowers, wordMod, threads))
+            {
+                strCombined += std::to_string(result);
+                strCombined += " ";
+            }
+        }
+        else
+        {
+            for (const mpz_class &result : modular::batchPow(values, powers, numMod, threads))
+            {
+                strCombined += result.get_str();
+                strCombined += " ";
+            }
+        }
+
+        char *resStr = new char[strCombined.size() + 1];
+        strcpy(resStr, strCombined.c_str());
+
+        size = strCombined.size();
+
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+
 /**
  *
  *    @brief Factorize a number modulo a given modulus.
@@ -262,6 +406,195 @@ factorizePolard(size_t &size, char *num, char *mod, char *errorStr)
 
     return nullptr;
 }
+
+/**
+ *
+ *    @brief Factorize a number with the elliptic curve method.
+ *    Suited to numbers with factors of 15 to 40 digits, the curves run on several threads.
+ *    @param size Reference to a variable that will hold the length of the result string.
+ *    @param num The number to factorize.
+ *    @param mod The modulus.
+ *    @param threads The number of worker threads, 0 for one per hardware thread.
+ *    @return A string of space separated prime factors.
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+factorizeECM(size_t &size, char *num, char *mod, size_t threads, char *errorStr)
+{
+    try
+    {
+        mpz_class numA, numMod;
+        numA.set_str(num, 10);
+        numMod.set_str(mod, 10);
+
+        modNum<mpz_class> a1(numA, numMod);
+
+        std::vector<modNum<mpz_class>> res = modular::ecmFactorize(a1, threads);
+
+        std::string strCombined;
+
+        for (modNum<mpz_class> num : res)
+        {
+            strCombined += num.getValue().get_str();
+            strCombined += " ";
+        }
+
+        char *resStr = new char[strCombined.size() + 1];
+        strcpy(resStr, strCombined.c_str());
+
+        size = strCombined.size();
+
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+/**
+ *
+ *    @brief Factorize a number with the self-initializing quadratic sieve.
+ *    Suited to products of two primes of similar size, the polynomials are sieved on several threads.
+ *    @param size Reference to a variable that will hold the length of the result string.
+ *    @param num The number to factorize.
+ *    @param mod The modulus.
+ *    @param threads The number of worker threads, 0 for one per hardware thread.
+ *    @return A string of space separated prime factors.
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+factorizeSIQS(size_t &size, char *num, char *mod, size_t threads, char *errorStr)
+{
+    try
+    {
+        mpz_class numA, numMod;
+        numA.set_str(num, 10);
+        numMod.set_str(mod, 10);
+
+        modNum<mpz_class> a1(numA, numMod);
+
+        std::vector<modNum<mpz_class>> res = modular::siqsFactorize(a1, threads);
+
+        std::string strCombined;
+
+        for (modNum<mpz_class> num : res)
+        {
+            strCombined += num.getValue().get_str();
+            strCombined += " ";
+        }
+
+        char *resStr = new char[strCombined.size() + 1];
+        strcpy(resStr, strCombined.c_str());
+
+        size = strCombined.size();
+
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+/**
+ *
+ *    @brief Factorize a number with Pollard's p - 1 method.
+ *    Finds the prime factors p with smooth p - 1 quickly, other factors fall back to Pollard's rho.
+ *    @param size Reference to a variable that will hold the length of the result string.
+ *    @param num The number to factorize.
+ *    @param mod The modulus.
+ *    @param bound The stage 1 bound B1, stage 2 goes up to 100 * B1.
+ *    @return A string of space separated prime factors.
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+factorizePM1(size_t &size, char *num, char *mod, unsigned long long bound, char *errorStr)
+{
+    try
+    {
+        mpz_class numA, numMod;
+        numA.set_str(num, 10);
+        numMod.set_str(mod, 10);
+
+        modNum<mpz_class> a1(numA, numMod);
+
+        std::vector<modNum<mpz_class>> res = modular::pm1Factorize(a1, bound);
+
+        std::string strCombined;
+
+        for (modNum<mpz_class> num : res)
+        {
+            strCombined += num.getValue().get_str();
+            strCombined += " ";
+        }
+
+        char *resStr = new char[strCombined.size() + 1];
+        strcpy(resStr, strCombined.c_str());
+
+        size = strCombined.size();
+
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+/**
+ *
+ *    @brief Factorize a number with Williams' p + 1 method.
+ *    Finds the prime factors p with smooth p + 1 quickly, other factors fall back to Pollard's rho.
+ *    @param size Reference to a variable that will hold the length of the result string.
+ *    @param num The number to factorize.
+ *    @param mod The modulus.
+ *    @param bound The stage 1 bound B1, stage 2 goes up to 100 * B1.
+ *    @return A string of space separated prime factors.
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+factorizePP1(size_t &size, char *num, char *mod, unsigned long long bound, char *errorStr)
+{
+    try
+    {
+        mpz_class numA, numMod;
+        numA.set_str(num, 10);
+        numMod.set_str(mod, 10);
+
+        modNum<mpz_class> a1(numA, numMod);
+
+        std::vector<modNum<mpz_class>> res = modular::pp1Factorize(a1, bound);
+
+        std::string strCombined;
+
+        for (modNum<mpz_class> num : res)
+        {
+            strCombined += num.getValue().get_str();
+            strCombined += " ";
+        }
+
+        char *resStr = new char[strCombined.size() + 1];
+        strcpy(resStr, strCombined.c_str());
+
+        size = strCombined.size();
+
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
 /*
  *    @brief Factorize a number modulo a given modulus.
  *    This function computes the prime factorization of a number modulo a given modulus.
@@ -527,5 +860,207 @@ isPrime(char *num, char *mod, char *iterations, char *errorStr)
     return false;
 }
 
+/**
+ *
+ *    @brief Finds the smallest prime greater than a number
+ *    @param num A char pointer to the number
+ *    @return A char pointer to the next prime in string form
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+nextPrime(char *num, char *errorStr)
+{
+    try
+    {
+        mpz_class numA;
+        numA.set_str(num, 10);
+
+        std::string res = modular::nextPrime(numA).get_str();
+        char *resStr = new char[res.size() + 1];
+        strcpy(resStr, res.c_str());
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+
+/**
+ *
+ *    @brief Finds the largest prime less than a number
+ *    @param num A char pointer to the number, greater than 2
+ *    @return A char pointer to the previous prime in string form
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+prevPrime(char *num, char *errorStr)
+{
+    try
+    {
+        mpz_class numA;
+        numA.set_str(num, 10);
+
+        std::string res = modular::prevPrime(numA).get_str();
+        char *resStr = new char[res.size() + 1];
+        strcpy(resStr, res.c_str());
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+
+/**
+ *
+ *    @brief Draws a random prime with an exact number of bits
+ *    @param bits The bit length, at least 2
+ *    @return A char pointer to the prime in string form
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+randomPrime(size_t bits, char *errorStr)
+{
+    try
+    {
+        std::string res = modular::randomPrime<mpz_class>(bits).get_str();
+        char *resStr = new char[res.size() + 1];
+        strcpy(resStr, res.c_str());
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+
+/**
+ *
+ *    @brief Tests many numbers for primality on a pool of threads
+ *    @param nums Array of numbers.
+ *    @param count The number of elements in nums.
+ *    @param threads The number of worker threads, 0 for one per hardware thread.
+ *    @return A string of count characters, '1' for a prime and '0' otherwise, in the order of nums.
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+isPrimeBatch(char **nums, size_t count, size_t threads, char *errorStr)
+{
+    try
+    {
+        std::vector<mpz_class> values(count);
+        for (size_t i = 0; i < count; ++i)
+            values[i].set_str(nums[i], 10);
+
+        std::vector<bool> prime = modular::isPrimeBatch(values, threads);
+        char *resStr = new char[count + 1];
+        for (size_t i = 0; i < count; ++i)
+            resStr[i] = prime[i] ? '1' : '0';
+        resStr[count] = '\0';
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+
+/**
+ *
+ *    @brief Tests every number of an interval [lo, hi) for primality
+ *    @param size Reference to a variable that will hold the length of the result string.
+ *    @param lo The inclusive lower bound.
+ *    @param hi The exclusive upper bound.
+ *    @param threads The number of worker threads, 0 for one per hardware thread.
+ *    @return A string with one character per number, '1' for a prime and '0' otherwise.
+ *    @note memory should be manualy freed by delete[]
+ *    */
+
+extern "C" char *
+primeBitmap(size_t &size, char *lo, char *hi, size_t threads, char *errorStr)
+{
+    try
+    {
+        mpz_class numLo, numHi;
+        numLo.set_str(lo, 10);
+        numHi.set_str(hi, 10);
+
+        std::vector<bool> prime;
+        if (numLo.fits_slong_p() && numHi.fits_slong_p())
+            prime = modular::primeBitmap<long long>(numLo.get_si(), numHi.get_si(), threads);
+        else
+            prime = modular::primeBitmap(numLo, numHi, threads);
+
+        size = prime.size();
+        char *resStr = new char[size + 1];
+        for (size_t i = 0; i < size; ++i)
+            resStr[i] = prime[i] ? '1' : '0';
+        resStr[size] = '\0';
+        return resStr;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+
+    return nullptr;
+}
+
+/**
+ *
+ *    @brief Writes the shared factorization cache to a file.
+ *    A later loadFactorCache lets a restarted process skip the cached factorizations.
+ *    @param path The file to write.
+ *    @return true on success, false otherwise
+ *    */
+extern "C" bool
+saveFactorCache(char *path, char *errorStr)
+{
+    try
+    {
+        modular::sharedFactorCache().save(path);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+    return false;
+}
+
+/**
+ *
+ *    @brief Adds the factorizations of a file written by saveFactorCache to the shared cache.
+ *    @param path The file to read.
+ *    @return true on success, false otherwise
+ *    */
+extern "C" bool
+loadFactorCache(char *path, char *errorStr)
+{
+    try
+    {
+        modular::sharedFactorCache().load(path);
+        return true;
+    }
+    catch (const std::exception &e)
+    {
+        strcpy(errorStr, e.what());
+    }
+    return false;
+}
+
 // Compile: g++ wrapper.cpp -lgmpxx -lgm
 // Wasm Compile: em++ finite-field/wrapper.cpp polynomial-ring/wrapper.cpp polynomial-field/wrapper.cpp -shared -L/home/emscripten/opt/lib  -I/home/emscripten/opt/include -lgmp -lgmpxx -o global-wrapper.o
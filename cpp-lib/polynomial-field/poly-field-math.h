@@ -8,9 +8,9 @@ using namespace modular;
 /**
  * @brief Checks if a number is prime using a simple primality test.
  *
- * This function checks if a number is prime by iterating from 2 to the square root
- * of the number and checking if the number is divisible by any of the iterated values.
- * If the number is divisible by any value in the range, it is considered non-prime.
+ * This function checks if a number is prime by trial division with the primes from 2 to
+ * the square root of the number, enumerated by the segmented sieve.
+ * If the number is divisible by any of them, it is considered non-prime.
  *
  * @param num The number to be checked for primality.
  * @return True if the number is prime, otherwise false.
@@ -20,9 +20,17 @@ template <typename T>
 bool isPrimeSimpleFunction(T num)
 {
     T check = sqrt(num);
+    if (check < 2)
+        return true;
 
-    for (int i = 2; i <= check; i++)
-        if (num % i == 0)
+    uint64_t limit;
+    if constexpr (std::is_same<T, mpz_class>::value)
+        limit = check.get_ui();
+    else
+        limit = static_cast<uint64_t>(check);
+
+    for (uint64_t p : primeRange(2, limit + 1))
+        if (num % static_cast<T>(p) == 0)
             return false;
     return true;
 }
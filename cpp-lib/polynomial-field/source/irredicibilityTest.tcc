@@ -27,7 +27,7 @@ irreducibilityTest(Polynomial<T> p){
     Polynomial<T> res = P.getValue();
     Node<T> first = res[0];
 
-    if (res.size() == 1 && first.deg() == 1 && first.k().getValue() == 1)
+    if (res.size() == 1 && first.deg() == 1 && first.k() == 1)
         return true;
     else
         return false;
@@ -16,7 +16,8 @@ using namespace modular;
  * @brief A class representing a node in a polynomial.
  *
  * The Node class represents a node in a polynomial, which consists of a coefficient
- * and a degree.
+ * and a degree. The coefficient is a bare residue, the modulus is kept once by the
+ * ring of the polynomial, so arithmetic on nodes takes that ring.
  *
  * @tparam T The type of the coefficient.
  */
@@ -25,7 +26,7 @@ class Node
 {
 protected:
     size_t degree;
-    modNum<T> koef;
+    T koef;
 
 public:
     /**
@@ -39,10 +40,19 @@ public:
      *
      * Constructs a Node object with the specified coefficient and degree.
      *
+     * @param koef The coefficient of the node, a residue in range [0, MOD).
+     * @param degree The degree of the node.
+     */
+    Node(T koef, size_t degree);
+    /**
+     * @brief Constructor for Node with a modNum coefficient.
+     *
+     * Only the value is kept, a polynomial reduces it modulo its own modulus when the node is added.
+     *
      * @param koef The coefficient of the node.
      * @param degree The degree of the node.
      */
-    Node(modNum<T> koef, size_t degree);
+    Node(const modNum<T> &koef, size_t degree);
     /**
      * @brief Default destructor for Node.
      */
@@ -58,9 +68,9 @@ public:
     /**
      * @brief Returns the coefficient of the node.
      *
-     * @return The coefficient of the node.
+     * @return The coefficient of the node, a residue modulo the modulus of its polynomial.
      */
-    modNum<T> k() const;
+    const T &k() const;
 
     bool operator>(const Node<T> &p2) const;
     bool operator>=(const Node<T> &p2) const;
@@ -74,9 +84,10 @@ public:
      * Adds the coefficients of two nodes and returns a new node with the sum.
      *
      * @param p2 The second node to be added.
+     * @param ring The ring of the coefficients.
      * @return A new node representing the sum of the two nodes.
      */
-    Node<T> operator+(const Node<T> &p2) const;
+    Node<T> add(const Node<T> &p2, const modRing<T> &ring) const;
 
     /**
      * @brief Subtracts two nodes.
@@ -85,9 +96,18 @@ public:
      * and returns a new node with the difference.
      *
      * @param p2 The second node to be subtracted.
+     * @param ring The ring of the coefficients.
      * @return A new node representing the difference of the two nodes.
      */
-    Node<T> operator-(const Node<T> &p2) const;
+    Node<T> subs(const Node<T> &p2, const modRing<T> &ring) const;
+
+    /**
+     * @brief Adds the coefficient of another node in place.
+     *
+     * @param p2 The node with the same degree.
+     * @param ring The ring of the coefficients.
+     */
+    void addAssign(const Node<T> &p2, const modRing<T> &ring);
 
     /**
      * @brief Assigns the value of another node to this node.
@@ -106,10 +126,11 @@ public:
      *
      * Evaluates the node by substituting the given value for the variable.
      *
+     * @param ring The ring of the coefficients.
      * @param value The value to substitute for the variable.
      * @return The evaluated value of the node.
      */
-    modNum<T> evaluate(T) const;
+    modNum<T> evaluate(const modRing<T> &ring, T value) const;
 };
 #endif
 
@@ -127,7 +148,7 @@ public:
  *    @brief A class representing a polynomial with coefficients of type T.
  *    This class provides functionality for manipulating and performing operations on polynomials.
  *    The coefficients of the polynomial are stored as a linked list of nodes, where each node represents a term
- *    in the polynomial.
+ *    in the polynomial. The nodes keep bare residues, the modulus is kept once, by the ring of the polynomial.
  *    @tparam T The type of coefficients in the polynomial.
  */
 template <typename T>
@@ -136,17 +157,25 @@ class Polynomial
 protected:
     std::list<Node<T>> poly;
     size_t degree = 0;
-    T numMod = 0;
+    modRing<T> ring = modRing<T>(1);
     /*
      * @brief Returns the coefficient of the node with the specified degree.
      *
      * Returns the coefficient of the node with the specified degree.
      *
      * @param power The degree of the node.
-     * @return The coefficient of the node.
+     * @return The coefficient of the node, 0 if there is no such node.
      *
      */
-    modNum<T> getCoeff(const size_t power);
+    T getCoeff(const size_t power);
+    /*
+     * @brief Adds a node whose coefficient is already reduced by the ring.
+     *
+     * A node with the same degree is merged with it, zero coefficients are kept.
+     *
+     * @param node The node to add.
+     */
+    void insertNode(const Node<T> &node);
     /*
      *@brief copy the polynomial
      *
@@ -178,7 +207,7 @@ public:
     Polynomial(T mod)
     {
         if (isPrime(modNum<T>(mod, mod + 1), 1000))
-            numMod = mod;
+            ring = modRing<T>(mod);
         else
             throw std::invalid_argument("Mod should be prime");
     };
@@ -307,7 +336,7 @@ public:
      *
      * @return The modulus of the polynomial.
      */
-    T getNumMod() const { return numMod; }
+    T getNumMod() const { return ring.getMod(); }
 
     /**
      * @brief Converts the polynomial to a vector representation.
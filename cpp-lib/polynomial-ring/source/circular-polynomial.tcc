@@ -196,7 +196,7 @@ template <typename T>
 void
 Polynomial<T>::fromCyclotomic(size_t N, T mod) {
     vector<T> v;
-    this->numMod = mod;
+    this->ring = modRing<T>(mod);
     if (N == 1) {
         v = std::vector<T>({1, -1});
     } else {
@@ -18,7 +18,7 @@ bool cmp(const std::pair<T, size_t> &one, const std::pair<T, size_t> &two)
 template <class T>
 Polynomial<T>::Polynomial(std::vector<std::pair<T, size_t>> nodes, T mod)
 {
-    this->numMod = mod;
+    this->ring = modRing<T>(mod);
 
     for (auto valDegreePair : nodes)
     {
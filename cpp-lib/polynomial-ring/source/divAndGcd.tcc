@@ -33,7 +33,7 @@ Polynomial<T>::divClassic(const Polynomial<T> &other) const
 
     else if (denomDeg == 0)
     {
-        modNum<T> numb(other.poly.begin()->k().getValue(), other.getNumMod());
+        modNum<T> numb(other.poly.begin()->k(), other.getNumMod());
         return this->divClassic(numb);
     }
     else
@@ -44,10 +44,10 @@ Polynomial<T>::divClassic(const Polynomial<T> &other) const
         while (numDeg >= denomDeg)
         {
             Polynomial<T> denomTmp = other.shiftRight(numDeg - denomDeg);
-            auto val = remainder.getCoeff(numDeg) / denomTmp.getCoeff(numDeg);
-            quotient.addNode(val.getValue(), numDeg - denomDeg);
+            T val = ring.div(remainder.getCoeff(numDeg), denomTmp.getCoeff(numDeg));
+            quotient.addNode(val, numDeg - denomDeg);
             Polynomial<T> num(quotient.getNumMod());
-            num.addNode(quotient.getCoeff(numDeg - denomDeg).getValue(), 0);
+            num.addNode(quotient.getCoeff(numDeg - denomDeg), 0);
 
             denomTmp = denomTmp * num;
 
@@ -72,11 +72,14 @@ Polynomial<T>::divClassic(const modNum<T> &other) const
 {
     Polynomial<T> remainder(this->getNumMod());
     Polynomial<T> quotient(this->getNumMod());
+    if (poly.empty())
+        return std::make_pair(quotient, remainder);
 
+    // one inversion for the whole polynomial, then a product per coefficient
+    T inverse = ring.inv(ring.element(other.getValue()));
     for (auto it = poly.begin(); it != poly.end(); ++it)
     {
-        auto val3 = it->k() / other;
-        quotient.addNode(val3.getValue(), it->deg());
+        quotient.addNode(ring.mult(it->k(), inverse), it->deg());
     }
 
     return std::make_pair(quotient, remainder);
@@ -148,9 +151,9 @@ Polynomial<T>::gcd(const Polynomial<T> &other) const
         h = divRes.second;
     }
 
-    if (!g.poly.empty() && g.poly.front().k().getValue() > 1)
+    if (!g.poly.empty() && g.poly.front().k() > 1)
     {
-        modNum<T> numb(g.poly.begin()->k().getValue(), g.getNumMod());
+        modNum<T> numb(g.poly.begin()->k(), g.getNumMod());
 
         auto res = g.divClassic(numb);
         g = res.first;
@@ -14,7 +14,10 @@ template <typename T>
 Node<T>::Node() : degree(0), koef(0) {}
 
 template <typename T>
-Node<T>::Node(modular::modNum<T> koef, size_t degree) : degree(degree), koef(koef) {}
+Node<T>::Node(T koef, size_t degree) : degree(degree), koef(std::move(koef)) {}
+
+template <typename T>
+Node<T>::Node(const modular::modNum<T> &koef, size_t degree) : degree(degree), koef(koef.getValue()) {}
 
 template <typename T>
 bool
@@ -54,26 +57,34 @@ Node<T>::operator!=(const Node<T> &p2) const {
 
 template <typename T>
 Node<T>
-Node<T>::operator+(const Node<T> &p2) const {
+Node<T>::add(const Node<T> &p2, const modRing<T> &ring) const {
     if (degree != p2.degree)
         throw std::logic_error("Can't add monomials with different powers");
     else {
-        Node<T> res(koef + p2.koef, degree);
+        Node<T> res(ring.add(koef, p2.koef), degree);
         return res;
     }
 }
 
 template <typename T>
 Node<T>
-Node<T>::operator-(const Node<T> &p2) const {
+Node<T>::subs(const Node<T> &p2, const modRing<T> &ring) const {
     if (degree != p2.degree)
         throw std::logic_error("Can't subtract monomials with different powers");
     else {
-        Node<T> res(koef - p2.koef, degree);
+        Node<T> res(ring.subs(koef, p2.koef), degree);
         return res;
     }
 }
 
+template <typename T>
+void
+Node<T>::addAssign(const Node<T> &p2, const modRing<T> &ring) {
+    if (degree != p2.degree)
+        throw std::logic_error("Can't add monomials with different powers");
+    ring.addAssign(koef, p2.koef);
+}
+
 template <typename T>
 void
 Node<T>::operator=(const Node<T> &p2) {
@@ -88,16 +99,16 @@ Node<T>::deg() const {
 }
 
 template <typename T>
-modNum<T>
+const T &
 Node<T>::k() const {
     return koef;
 }
 template <typename T>
 modNum<T>
-Node<T>::evaluate(T xVal) const {
-    modNum<T> res(xVal, koef.getMod());
-    res = fpow(res, degree);
-    res = res * koef;
+Node<T>::evaluate(const modRing<T> &ring, T xVal) const {
+    modNum<T> res(xVal, ring.getMod());
+    res = fpow(res, static_cast<T>(degree));
+    res *= ring.toModNum(koef);
     return res;
 }
 #endif
\ No newline at end of file
@@ -33,7 +33,7 @@ template <typename T>
 std::ostream &
 operator<<(std::ostream &os, Node<T> &p)
 {
-    return os << '{' << p.deg() << ", " << p.k().getValue() << '}';
+    return os << '{' << p.deg() << ", " << p.k() << '}';
 }
 
 template <typename T>
@@ -41,20 +41,17 @@ Polynomial<T>
 Polynomial<T>::der() const
 {
     Polynomial<T> returned_field;
-    Node<T> current_newnode;
-    modNum<T> new_koef;
+    returned_field.ring = ring;
+    T new_koef;
     size_t new_pow;
 
     for (auto it = poly.begin(); it != poly.end(); ++it)
     {
-        new_koef = (it->k() * modNum<T>(static_cast<T>(it->deg()), this->numMod));
+        new_koef = ring.mult(it->k(), ring.element(static_cast<T>(it->deg())));
         new_pow = (it->deg() == 0 ? 0 : it->deg() - 1);
 
-        if (new_koef.getValue() > 0)
-        {
-            current_newnode = Node<T>(new_koef, new_pow);
-            returned_field.addNode(current_newnode);
-        }
+        if (new_koef > 0)
+            returned_field.insertNode(Node<T>(new_koef, new_pow));
     }
 
     return returned_field;
@@ -64,24 +61,23 @@ template <typename T>
 modNum<T>
 Polynomial<T>::evaluate(const T x_value) const
 {
-    modNum<T> sum(0, numMod);
-    modNum<T> current_num(0, numMod);
+    T sum = ring.element(0);
+    modNum<T> point(x_value, ring.getMod());
 
     for (auto it = poly.begin(); it != poly.end(); ++it)
     {
         if (it->deg() > 0)
         {
             T nodeDegree = static_cast<T>(it->deg());
-            current_num = fpow(modNum<T>(x_value, numMod), nodeDegree) * it->k();
+            ring.addAssign(sum, ring.mult(fpow(point, nodeDegree).getValue(), it->k()));
         }
         else
         {
-            current_num = it->k();
+            ring.addAssign(sum, it->k());
         }
-        sum = sum + current_num;
     }
 
-    return sum;
+    return ring.toModNum(sum);
 }
 
 template <typename T>
@@ -115,14 +111,14 @@ void Polynomial<T>::print() const
         }
         if (it->deg() > 0)
         {
-            if (it->k().getValue() > 1)
-                std::cout << (it->k().getValue()) << "x^" << (it->deg());
+            if (it->k() > 1)
+                std::cout << (it->k()) << "x^" << (it->deg());
             else
                 std::cout << "x^" << (it->deg());
         }
         else
         {
-            std::cout << (it->k().getValue());
+            std::cout << (it->k());
         }
     }
     std::cout << std::endl;
@@ -130,11 +126,22 @@ void Polynomial<T>::print() const
 
 /*
  * @brief Adds a node to the polynomial.
- * @param node The node to add to the polynomial.
+ * @param node The node to add to the polynomial, its coefficient is reduced by the ring.
  */
 
 template <typename T>
 void Polynomial<T>::addNode(const Node<T> node)
+{
+    insertNode(Node<T>(ring.element(node.k()), node.deg()));
+}
+
+/*
+ * @brief Adds a node with a reduced coefficient to the polynomial.
+ * @param node The node to add to the polynomial.
+ */
+
+template <typename T>
+void Polynomial<T>::insertNode(const Node<T> &node)
 {
     if (node.deg() > degree)
     {
@@ -147,7 +154,7 @@ void Polynomial<T>::addNode(const Node<T> node)
     {
         if (it->deg() == node.deg())
         {
-            *it = *it + node;
+            it->addAssign(node, ring);
             return;
         }
         if (it->deg() < node.deg())
@@ -168,11 +175,9 @@ void Polynomial<T>::addNode(const Node<T> node)
 template <typename T>
 void Polynomial<T>::addNode(const T num, size_t deg)
 {
-    if (static_cast<T>(((num + numMod) % numMod) > 0))
-    {
-        Node<T> a(modNum<T>(((num + numMod) % numMod), numMod), deg);
-        this->addNode(a);
-    }
+    T residue = ring.element(num);
+    if (residue > 0)
+        insertNode(Node<T>(residue, deg));
 }
 
 /**
@@ -184,7 +189,11 @@ template <typename T> // mpz_class libGMP
 Polynomial<T>
 Polynomial<T>::operator+(const Polynomial<T> &other) const
 {
-    Polynomial<T> result(this->numMod);
+    if (this->getNumMod() != other.getNumMod())
+    {
+        throw std::invalid_argument("Can't add Polynomials with diferent modulas");
+    }
+    Polynomial<T> result(this->getNumMod());
     result.degree = std::max(this->degree, other.degree);
 
     auto it = this->poly.begin();
@@ -194,41 +203,35 @@ Polynomial<T>::operator+(const Polynomial<T> &other) const
     {
         if (it->deg() == io->deg())
         {
-            modNum<T> t1 = it->k();
-            modNum<T> t2 = io->k();
-            modNum<T> temp = t1 + t2;
-            if (temp.getValue() != 0)
-                result.addNode(temp.getValue(), it->deg());
+            T temp = ring.add(it->k(), io->k());
+            if (temp != 0)
+                result.insertNode(Node<T>(temp, it->deg()));
             it++;
             io++;
         }
         else if (it->deg() > io->deg())
         {
-            modNum<T> t = it->k();
-            modNum<T> temp = t;
-            result.addNode(temp.getValue(), it->deg());
+            if (it->k() != 0)
+                result.insertNode(*it);
             it++;
         }
         else
         {
-            modNum<T> t = io->k();
-            modNum<T> temp = t;
-            result.addNode(temp.getValue(), io->deg());
+            if (io->k() != 0)
+                result.insertNode(*io);
             io++;
         }
     }
     while (it != this->poly.end())
     {
-        modNum<T> t = it->k();
-        modNum<T> temp = t + (modNum<T>(0));
-        result.addNode(temp.getValue(), it->deg());
+        if (it->k() != 0)
+            result.insertNode(*it);
         it++;
     }
     while (io != other.poly.end())
     {
-        modNum<T> t = io->k();
-        modNum<T> temp = t + (modNum<T>(0));
-        result.addNode(temp.getValue(), io->deg());
+        if (io->k() != 0)
+            result.insertNode(*io);
         io++;
     }
     return result;
@@ -243,7 +246,11 @@ template <typename T>
 Polynomial<T>
 Polynomial<T>::operator-(const Polynomial<T> &other) const
 {
-    Polynomial<T> result(this->numMod);
+    if (this->getNumMod() != other.getNumMod())
+    {
+        throw std::invalid_argument("Can't add Polynomials with diferent modulas");
+    }
+    Polynomial<T> result(this->getNumMod());
 
     auto it = this->poly.begin();
     auto io = other.poly.begin();
@@ -252,43 +259,37 @@ Polynomial<T>::operator-(const Polynomial<T> &other) const
     {
         if (it->deg() == io->deg())
         {
-            modNum<T> t1 = it->k();
-            modNum<T> t2 = io->k();
-            modNum<T> temp = t1 - (t2);
+            T temp = ring.subs(it->k(), io->k());
 
-            if (temp.getValue() != 0)
-                result.addNode(temp.getValue(), it->deg());
+            if (temp != 0)
+                result.insertNode(Node<T>(temp, it->deg()));
 
             it++;
             io++;
         }
         else if (it->deg() > io->deg())
         {
-            modNum<T> t = it->k();
-            modNum<T> temp = t + (modNum<T>(0));
-            result.addNode(temp.getValue(), it->deg());
+            if (it->k() != 0)
+                result.insertNode(*it);
             it++;
         }
         else
         {
-            modNum<T> t = io->k();
-            modNum<T> temp = (modNum<T>(0, numMod)) - t;
-            result.addNode(temp.getValue(), io->deg());
+            if (io->k() != 0)
+                result.insertNode(Node<T>(ring.subs(0, io->k()), io->deg()));
             io++;
         }
     }
     while (it != this->poly.end())
     {
-        modNum<T> t = it->k();
-        modNum<T> temp = t + (modNum<T>(0));
-        result.addNode(temp.getValue(), it->deg());
+        if (it->k() != 0)
+            result.insertNode(*it);
         it++;
     }
     while (io != other.poly.end())
     {
-        modNum<T> t = io->k();
-        modNum<T> temp = (modNum<T>(0, numMod)) - t;
-        result.addNode(temp.getValue(), io->deg());
+        if (io->k() != 0)
+            result.insertNode(Node<T>(ring.subs(0, io->k()), io->deg()));
         io++;
     }
 
@@ -310,12 +311,12 @@ Polynomial<T>::operator*(const Polynomial<T> &other) const
     }
     if (this->poly.empty() || other.poly.empty())
     {
-        Polynomial<T> result(this->numMod);
+        Polynomial<T> result(this->getNumMod());
         return result;
     }
 
     std::size_t s = this->poly.size() + other.poly.size() - 1;
-    Polynomial<T> result(this->numMod);
+    Polynomial<T> result(this->getNumMod());
     result.degree = s - 1;
     auto it = this->poly.begin();
 
@@ -324,10 +325,7 @@ Polynomial<T>::operator*(const Polynomial<T> &other) const
         auto io = other.poly.begin();
         while (io != other.poly.end())
         {
-            modNum<T> t1 = it->k();
-            modNum<T> t2 = io->k();
-            modNum<T> temp = t1 * t2;
-            result.addNode(Node<T>(temp, it->deg() + io->deg()));
+            result.insertNode(Node<T>(ring.mult(it->k(), io->k()), it->deg() + io->deg()));
             io++;
         }
         it++;
@@ -336,9 +334,10 @@ Polynomial<T>::operator*(const Polynomial<T> &other) const
     auto temp = result.poly.begin();
     while (temp != result.poly.end())
     {
-        if ((temp->k()).getValue() == 0)
+        if (temp->k() == 0)
             temp = result.poly.erase(temp);
-        temp++;
+        else
+            temp++;
     }
     return result;
 }
@@ -357,7 +356,7 @@ bool Polynomial<T>::operator==(const Polynomial<T> &other) const
         auto io = other.poly.begin();
         while (it != this->poly.end() && io != other.poly.end())
         {
-            if (it->deg() != io->deg() || (it->k()).getValue() != (io->k()).getValue())
+            if (it->deg() != io->deg() || it->k() != io->k())
                 return false;
             it++;
             io++;
@@ -393,7 +392,7 @@ Polynomial<T>::copy() const
 {
     Polynomial<T> newPol(this->getNumMod());
     for (auto it = this->begin(); it != this->end(); ++it)
-        newPol.addNode(Node<T>(it->k(), it->deg()));
+        newPol.insertNode(*it);
 
     return newPol;
 }
@@ -404,8 +403,7 @@ Polynomial<T>::copy() const
  * @return coefficient of monomial
  */
 template <typename T>
-modNum<T>
-Polynomial<T>::getCoeff(const size_t power)
+T Polynomial<T>::getCoeff(const size_t power)
 {
     if (power < 0 || power > this->getDegree())
         throw std::out_of_range("Index out of range");
@@ -436,7 +434,7 @@ Polynomial<T>::shiftRight(int positions) const
 
     for (auto it = poly.begin(); it != poly.end(); ++it)
     {
-        tmp.addNode(it->k().getValue(), it->deg() + positions);
+        tmp.addNode(it->k(), it->deg() + positions);
         tmp.poly.remove(Node<T>(it->k(), it->deg()));
     }
 
@@ -460,7 +458,7 @@ Polynomial<T>::toPolyVector()
 
     for (Node<T> nd : poly)
     {
-        resV.push_back(make_pair(nd.k().getValue(), nd.deg()));
+        resV.push_back(make_pair(nd.k(), nd.deg()));
     }
 
     return resV;
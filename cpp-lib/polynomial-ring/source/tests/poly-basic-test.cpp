@@ -460,4 +460,27 @@ TEST_CASE("New constructor")
     Polynomial<int> poly3_test();
 
     poly3.print();
-}
\ No newline at end of file
+}
+TEST_CASE("Coefficients are bare residues of the polynomial ring")
+{
+    // a node keeps its degree and one residue, the modulus lives in the polynomial
+    CHECK(sizeof(Node<long long>) == sizeof(size_t) + sizeof(long long));
+    CHECK(sizeof(Node<mpz_class>) == sizeof(size_t) + sizeof(mpz_class));
+
+    Polynomial<long long> p(7);
+    p.addNode(Node<long long>(modNum<long long>(12, 13), 2));
+    p.addNode(-1, 0);
+    p.addNode(9, 2);
+
+    std::vector<std::pair<long long, size_t>> expected = {{0, 2}, {6, 0}};
+    REQUIRE(p.toPolyVector() == expected);
+    REQUIRE(p.evaluate(3).getValue() == 6);
+
+    Polynomial<long long> q(7);
+    q.addNode(3, 1);
+    q.addNode(1, 0);
+    REQUIRE((q * q).toPolyVector() == std::vector<std::pair<long long, size_t>>{{2, 2}, {6, 1}, {1, 0}});
+    REQUIRE(q.der().getNumMod() == 7);
+    REQUIRE(q.der().toPolyVector() == std::vector<std::pair<long long, size_t>>{{3, 0}});
+    REQUIRE_THROWS_AS(q + Polynomial<long long>(11), std::invalid_argument);
+}
@@ -35,9 +35,9 @@ Polynomial<T>::toString() const
             }
             if (it->deg() > 0)
             {
-                if (it->k().getValue() > 1)
+                if (it->k() > 1)
                 {
-                    ss << (it->k().getValue()) << "x^" << (it->deg());
+                    ss << (it->k()) << "x^" << (it->deg());
                 }
                 else
                 {
@@ -46,7 +46,7 @@ Polynomial<T>::toString() const
             }
             else
             {
-                ss << (it->k().getValue());
+                ss << (it->k());
             }
         }
     }